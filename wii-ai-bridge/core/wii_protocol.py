@@ -0,0 +1,500 @@
+"""
+Binary wire protocol for the Wii AI Bridge.
+
+Mirrors wii/include/ai_protocol.h byte for byte: packed, versioned,
+little-endian frames with a fixed 12-byte header. The Wii encodes
+requests and decodes responses in C; this module is the matching
+Python side used by the AI engine's UDP loop.
+
+Layout changes must bump PROTOCOL_VERSION on both sides.
+"""
+
+import struct
+from dataclasses import dataclass, field
+from typing import List, Optional, Tuple
+
+PROTOCOL_MAGIC = 0x4257  # "WB"
+PROTOCOL_VERSION = 2
+
+# UDP port the AI engine listens on; the Wii sends here
+# (AI_ENGINE_PORT in ai_protocol.h)
+AI_ENGINE_PORT = 8080
+
+PKT_REQUEST = 1
+PKT_RESPONSE = 2
+PKT_BATCH_REQUEST = 3
+PKT_BATCH_RESPONSE = 4
+PKT_BATCH_DELTA = 5
+
+# u16 magic, u8 version, u8 type, u32 sequence, u16 payload_len, u16 reserved
+HEADER_FORMAT = "<HBBIHH"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+# Request fixed block (72 bytes): identity, gesture, profile, game state
+REQUEST_FIXED_FORMAT = "<BBBBQBBHfffffIIf4iII"
+REQUEST_FIXED_SIZE = struct.calcsize(REQUEST_FIXED_FORMAT)
+
+# One input snapshot (48 bytes)
+SNAPSHOT_FORMAT = "<IIBBHI8f"
+SNAPSHOT_SIZE = struct.calcsize(SNAPSHOT_FORMAT)
+
+# Response payload (32 bytes)
+RESPONSE_FORMAT = "<BBHQfffff"
+RESPONSE_SIZE = struct.calcsize(RESPONSE_FORMAT)
+
+# Batch shared block (40 bytes): timestamp + single game state copy
+BATCH_SHARED_FORMAT = "<QBBBBIIf4i"
+BATCH_SHARED_SIZE = struct.calcsize(BATCH_SHARED_FORMAT)
+
+# Per-player slice fixed block (24 bytes)
+SLICE_FIXED_FORMAT = "<BBBBfffff"
+SLICE_FIXED_SIZE = struct.calcsize(SLICE_FIXED_FORMAT)
+
+# Delta batch fixed block (16 bytes): timestamp, frame count, dirty
+# mask, player count, pad. Dirty game-state fields follow in bit
+# order, then the player slices as in a full batch.
+DELTA_FIXED_FORMAT = "<QIBBH"
+DELTA_FIXED_SIZE = struct.calcsize(DELTA_FIXED_FORMAT)
+
+# GameState dirty bits (mirror GS_DIRTY_* in wii/include/game_state.h)
+GS_DIRTY_GAME_TYPE = 0x01
+GS_DIRTY_AI_ENABLED = 0x02
+GS_DIRTY_LEVEL = 0x04
+GS_DIRTY_DIFFICULTY = 0x08
+GS_DIRTY_SCORE_SHIFT = 4  # bits 4..7: one per player score
+
+SNAPSHOT_FLAG_IR_VALID = 0x01
+SNAPSHOT_FLAG_GYRO_VALID = 0x02
+
+# Packed delta snapshots (protocol v2): inside a batch slice only the
+# first snapshot is a full block; the rest carry a presence mask and
+# quantized s8 per-field deltas against the previous snapshot,
+# escaping to absolute f32 when a delta overflows its scale.
+PACKED_BTN_HELD = 0x01    # u32 buttons_held follows
+PACKED_BTN_EDGE = 0x02    # u32 buttons_pressed follows
+PACKED_ACCEL_WIDE = 0x04  # accel absolute (3 f32)
+PACKED_IR_VALID = 0x08
+PACKED_IR_WIDE = 0x10     # ir absolute (2 f32)
+PACKED_GYRO_VALID = 0x20
+PACKED_GYRO_WIDE = 0x40   # gyro absolute (3 f32)
+
+# Quantization scales (value units per s8 LSB); mirror AI_PROTO_*_QUANT
+ACCEL_QUANT = 1.0 / 64.0
+IR_QUANT = 0.5
+GYRO_QUANT = 1.0 / 16.0
+
+
+class ProtocolError(ValueError):
+    """Raised for malformed or mismatched frames."""
+
+
+@dataclass
+class InputSnapshot:
+    """Decoded Wii Remote input sample."""
+    buttons_held: int
+    buttons_pressed: int
+    ir_valid: bool
+    gyro_valid: bool
+    timestamp_delta: int
+    accel: Tuple[float, float, float]
+    ir: Tuple[float, float]
+    gyro: Tuple[float, float, float]
+
+
+@dataclass
+class BridgeRequest:
+    """Decoded AI request from the Wii."""
+    sequence: int
+    player_id: int
+    game_type: int
+    ai_enabled: bool
+    timestamp: int
+    gesture_type: int
+    gesture_intensity: float
+    gesture_confidence: float
+    skill_level: float
+    learning_rate: float
+    adaptation_speed: float
+    current_level: int
+    frame_count: int
+    difficulty: float
+    player_scores: Tuple[int, int, int, int]
+    inputs: List[InputSnapshot] = field(default_factory=list)
+
+
+@dataclass
+class BridgeResponse:
+    """AI response to encode for the Wii."""
+    player_id: int
+    timestamp: int
+    difficulty_adjustment: float
+    learning_rate_adjustment: float
+    enhancement_enabled: bool
+    sensitivity_multiplier: float
+    npc_aggression: float
+    npc_intelligence: float
+
+
+@dataclass
+class PlayerSlice:
+    """One player's portion of a batched request."""
+    player_id: int
+    gesture_type: int
+    gesture_intensity: float
+    gesture_confidence: float
+    skill_level: float
+    learning_rate: float
+    adaptation_speed: float
+    inputs: List[InputSnapshot] = field(default_factory=list)
+
+
+@dataclass
+class BatchRequest:
+    """Decoded multi-player batch request from the Wii."""
+    sequence: int
+    timestamp: int
+    game_type: int
+    ai_enabled: bool
+    current_level: int
+    frame_count: int
+    difficulty: float
+    player_scores: Tuple[int, int, int, int]
+    players: List[PlayerSlice] = field(default_factory=list)
+
+
+def _parse_header(data: bytes, expected_type: int) -> Tuple[int, int]:
+    """Validate the frame header; returns (sequence, payload_len)."""
+    if len(data) < HEADER_SIZE:
+        raise ProtocolError("frame shorter than header")
+    magic, version, pkt_type, sequence, payload_len, _ = struct.unpack_from(
+        HEADER_FORMAT, data, 0)
+    if magic != PROTOCOL_MAGIC:
+        raise ProtocolError(f"bad magic 0x{magic:04x}")
+    if version != PROTOCOL_VERSION:
+        raise ProtocolError(f"unsupported protocol version {version}")
+    if pkt_type != expected_type:
+        raise ProtocolError(f"unexpected packet type {pkt_type}")
+    if len(data) < HEADER_SIZE + payload_len:
+        raise ProtocolError("truncated frame")
+    return sequence, payload_len
+
+
+def decode_request(data: bytes) -> BridgeRequest:
+    """Decode an AI request frame sent by the Wii."""
+    sequence, payload_len = _parse_header(data, PKT_REQUEST)
+    if payload_len < REQUEST_FIXED_SIZE:
+        raise ProtocolError("request payload shorter than fixed block")
+
+    fields = struct.unpack_from(REQUEST_FIXED_FORMAT, data, HEADER_SIZE)
+    (player_id, input_count, game_type, ai_enabled, timestamp,
+     gesture_type, _pad1, _pad2, intensity, confidence,
+     skill_level, learning_rate, adaptation_speed,
+     current_level, frame_count, difficulty,
+     score0, score1, score2, score3, _res0, _res1) = fields
+
+    expected_len = REQUEST_FIXED_SIZE + input_count * SNAPSHOT_SIZE
+    if payload_len != expected_len:
+        raise ProtocolError(
+            f"payload length {payload_len} != expected {expected_len}")
+
+    inputs = []
+    offset = HEADER_SIZE + REQUEST_FIXED_SIZE
+    for _ in range(input_count):
+        (buttons_held, buttons_pressed, flags, _p1, _p2, ts_delta,
+         ax, ay, az, ir_x, ir_y, pitch, roll, yaw) = struct.unpack_from(
+            SNAPSHOT_FORMAT, data, offset)
+        inputs.append(InputSnapshot(
+            buttons_held=buttons_held,
+            buttons_pressed=buttons_pressed,
+            ir_valid=bool(flags & SNAPSHOT_FLAG_IR_VALID),
+            gyro_valid=bool(flags & SNAPSHOT_FLAG_GYRO_VALID),
+            timestamp_delta=ts_delta,
+            accel=(ax, ay, az),
+            ir=(ir_x, ir_y),
+            gyro=(pitch, roll, yaw),
+        ))
+        offset += SNAPSHOT_SIZE
+
+    return BridgeRequest(
+        sequence=sequence,
+        player_id=player_id,
+        game_type=game_type,
+        ai_enabled=bool(ai_enabled),
+        timestamp=timestamp,
+        gesture_type=gesture_type,
+        gesture_intensity=intensity,
+        gesture_confidence=confidence,
+        skill_level=skill_level,
+        learning_rate=learning_rate,
+        adaptation_speed=adaptation_speed,
+        current_level=current_level,
+        frame_count=frame_count,
+        difficulty=difficulty,
+        player_scores=(score0, score1, score2, score3),
+        inputs=inputs,
+    )
+
+
+def _decode_snapshot(data: bytes, offset: int) -> InputSnapshot:
+    """Decode one input snapshot block."""
+    (buttons_held, buttons_pressed, flags, _p1, _p2, ts_delta,
+     ax, ay, az, ir_x, ir_y, pitch, roll, yaw) = struct.unpack_from(
+        SNAPSHOT_FORMAT, data, offset)
+    return InputSnapshot(
+        buttons_held=buttons_held,
+        buttons_pressed=buttons_pressed,
+        ir_valid=bool(flags & SNAPSHOT_FLAG_IR_VALID),
+        gyro_valid=bool(flags & SNAPSHOT_FLAG_GYRO_VALID),
+        timestamp_delta=ts_delta,
+        accel=(ax, ay, az),
+        ir=(ir_x, ir_y),
+        gyro=(pitch, roll, yaw),
+    )
+
+
+def _decode_packed_snapshot(data: bytes, offset: int, end: int,
+                            prev: InputSnapshot) -> Tuple[InputSnapshot, int]:
+    """Decode one packed delta snapshot; returns (snapshot, new offset)."""
+    try:
+        flags = data[offset]
+        offset += 1
+        (ts_delta,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+
+        if flags & PACKED_ACCEL_WIDE:
+            accel = struct.unpack_from("<3f", data, offset)
+            offset += 12
+        else:
+            dx, dy, dz = struct.unpack_from("<3b", data, offset)
+            offset += 3
+            accel = (prev.accel[0] + dx * ACCEL_QUANT,
+                     prev.accel[1] + dy * ACCEL_QUANT,
+                     prev.accel[2] + dz * ACCEL_QUANT)
+
+        buttons_held = prev.buttons_held
+        if flags & PACKED_BTN_HELD:
+            (buttons_held,) = struct.unpack_from("<I", data, offset)
+            offset += 4
+        buttons_pressed = 0
+        if flags & PACKED_BTN_EDGE:
+            (buttons_pressed,) = struct.unpack_from("<I", data, offset)
+            offset += 4
+
+        ir = (0.0, 0.0)
+        ir_valid = bool(flags & PACKED_IR_VALID)
+        if ir_valid:
+            if flags & PACKED_IR_WIDE:
+                ir = struct.unpack_from("<2f", data, offset)
+                offset += 8
+            else:
+                dx, dy = struct.unpack_from("<2b", data, offset)
+                offset += 2
+                ir = (prev.ir[0] + dx * IR_QUANT, prev.ir[1] + dy * IR_QUANT)
+
+        gyro = (0.0, 0.0, 0.0)
+        gyro_valid = bool(flags & PACKED_GYRO_VALID)
+        if gyro_valid:
+            if flags & PACKED_GYRO_WIDE:
+                gyro = struct.unpack_from("<3f", data, offset)
+                offset += 12
+            else:
+                dp, dr, dw = struct.unpack_from("<3b", data, offset)
+                offset += 3
+                gyro = (prev.gyro[0] + dp * GYRO_QUANT,
+                        prev.gyro[1] + dr * GYRO_QUANT,
+                        prev.gyro[2] + dw * GYRO_QUANT)
+    except (IndexError, struct.error):
+        raise ProtocolError("truncated packed snapshot") from None
+    if offset > end:
+        raise ProtocolError("truncated packed snapshot")
+
+    return InputSnapshot(
+        buttons_held=buttons_held,
+        buttons_pressed=buttons_pressed,
+        ir_valid=ir_valid,
+        gyro_valid=gyro_valid,
+        timestamp_delta=ts_delta,
+        accel=accel,
+        ir=ir,
+        gyro=gyro,
+    ), offset
+
+
+def decode_batch_request(data: bytes) -> BatchRequest:
+    """Decode a batched multi-player request frame."""
+    sequence, payload_len = _parse_header(data, PKT_BATCH_REQUEST)
+    if payload_len < BATCH_SHARED_SIZE:
+        raise ProtocolError("batch payload shorter than shared block")
+
+    (timestamp, game_type, ai_enabled, player_count, _pad,
+     current_level, frame_count, difficulty,
+     score0, score1, score2, score3) = struct.unpack_from(
+        BATCH_SHARED_FORMAT, data, HEADER_SIZE)
+
+    batch = BatchRequest(
+        sequence=sequence,
+        timestamp=timestamp,
+        game_type=game_type,
+        ai_enabled=bool(ai_enabled),
+        current_level=current_level,
+        frame_count=frame_count,
+        difficulty=difficulty,
+        player_scores=(score0, score1, score2, score3),
+    )
+
+    end = HEADER_SIZE + payload_len
+    offset = HEADER_SIZE + BATCH_SHARED_SIZE
+    batch.players = _decode_player_slices(data, offset, end, player_count)
+    return batch
+
+
+def _decode_player_slices(data: bytes, offset: int, end: int,
+                          player_count: int) -> List[PlayerSlice]:
+    """Decode the player slice array shared by batch and delta frames."""
+    players = []
+    for _ in range(player_count):
+        if offset + SLICE_FIXED_SIZE > end:
+            raise ProtocolError("truncated player slice")
+        (player_id, input_count, gesture_type, _pad,
+         intensity, confidence, skill_level, learning_rate,
+         adaptation_speed) = struct.unpack_from(
+            SLICE_FIXED_FORMAT, data, offset)
+        offset += SLICE_FIXED_SIZE
+
+        # First snapshot full, the rest packed deltas against it
+        inputs = []
+        if input_count > 0:
+            if offset + SNAPSHOT_SIZE > end:
+                raise ProtocolError("truncated input snapshots")
+            inputs.append(_decode_snapshot(data, offset))
+            offset += SNAPSHOT_SIZE
+        for _ in range(input_count - 1):
+            snapshot, offset = _decode_packed_snapshot(
+                data, offset, end, inputs[-1])
+            inputs.append(snapshot)
+
+        players.append(PlayerSlice(
+            player_id=player_id,
+            gesture_type=gesture_type,
+            gesture_intensity=intensity,
+            gesture_confidence=confidence,
+            skill_level=skill_level,
+            learning_rate=learning_rate,
+            adaptation_speed=adaptation_speed,
+            inputs=inputs,
+        ))
+
+    if offset != end:
+        raise ProtocolError("trailing bytes in batch payload")
+    return players
+
+
+def decode_batch_delta(data: bytes,
+                       base: Optional[BatchRequest] = None) -> BatchRequest:
+    """Decode a delta batch frame against the last known game state.
+
+    Fields without a dirty bit keep their value from `base` (the most
+    recently decoded batch or delta). Without a base — a server that
+    joined mid-stream — the Wii-side initial state is assumed until
+    the next keyframe corrects it.
+    """
+    sequence, payload_len = _parse_header(data, PKT_BATCH_DELTA)
+    if payload_len < DELTA_FIXED_SIZE:
+        raise ProtocolError("delta payload shorter than fixed block")
+
+    timestamp, frame_count, dirty, player_count, _pad = struct.unpack_from(
+        DELTA_FIXED_FORMAT, data, HEADER_SIZE)
+
+    if base is not None:
+        game_type = base.game_type
+        ai_enabled = base.ai_enabled
+        current_level = base.current_level
+        difficulty = base.difficulty
+        scores = list(base.player_scores)
+    else:
+        # Mirror init_game_state() on the Wii side
+        game_type = 0
+        ai_enabled = True
+        current_level = 0
+        difficulty = 0.5
+        scores = [0, 0, 0, 0]
+
+    end = HEADER_SIZE + payload_len
+    offset = HEADER_SIZE + DELTA_FIXED_SIZE
+    try:
+        if dirty & GS_DIRTY_GAME_TYPE:
+            game_type = data[offset]
+            offset += 1
+        if dirty & GS_DIRTY_AI_ENABLED:
+            ai_enabled = bool(data[offset])
+            offset += 1
+        if dirty & GS_DIRTY_LEVEL:
+            (current_level,) = struct.unpack_from("<i", data, offset)
+            offset += 4
+        if dirty & GS_DIRTY_DIFFICULTY:
+            (difficulty,) = struct.unpack_from("<f", data, offset)
+            offset += 4
+        for i in range(4):
+            if dirty & (1 << (GS_DIRTY_SCORE_SHIFT + i)):
+                (scores[i],) = struct.unpack_from("<i", data, offset)
+                offset += 4
+    except (IndexError, struct.error):
+        raise ProtocolError("truncated delta fields") from None
+    if offset > end:
+        raise ProtocolError("truncated delta fields")
+
+    batch = BatchRequest(
+        sequence=sequence,
+        timestamp=timestamp,
+        game_type=game_type,
+        ai_enabled=ai_enabled,
+        current_level=current_level,
+        frame_count=frame_count,
+        difficulty=difficulty,
+        player_scores=tuple(scores),
+    )
+    batch.players = _decode_player_slices(data, offset, end, player_count)
+    return batch
+
+
+def _pack_response_payload(response: BridgeResponse) -> bytes:
+    """Pack one response payload block."""
+    flags = 0x01 if response.enhancement_enabled else 0x00
+    return struct.pack(
+        RESPONSE_FORMAT,
+        response.player_id,
+        flags,
+        0,
+        response.timestamp,
+        response.difficulty_adjustment,
+        response.learning_rate_adjustment,
+        response.sensitivity_multiplier,
+        response.npc_aggression,
+        response.npc_intelligence,
+    )
+
+
+def encode_response(response: BridgeResponse, sequence: int) -> bytes:
+    """Encode an AI response frame for the Wii."""
+    payload = _pack_response_payload(response)
+    header = struct.pack(HEADER_FORMAT, PROTOCOL_MAGIC, PROTOCOL_VERSION,
+                         PKT_RESPONSE, sequence, len(payload), 0)
+    return header + payload
+
+
+def encode_batch_response(responses: List[BridgeResponse],
+                          sequence: int) -> bytes:
+    """Encode a batched response frame answering a batch request."""
+    payload = struct.pack("<BBH", len(responses), 0, 0)
+    for response in responses:
+        payload += _pack_response_payload(response)
+    header = struct.pack(HEADER_FORMAT, PROTOCOL_MAGIC, PROTOCOL_VERSION,
+                         PKT_BATCH_RESPONSE, sequence, len(payload), 0)
+    return header + payload
+
+
+def packet_type(data: bytes) -> int:
+    """Peek at the packet type of a frame (for dispatch)."""
+    if len(data) < HEADER_SIZE:
+        raise ProtocolError("frame shorter than header")
+    return data[3]
@@ -0,0 +1,28 @@
+/*
+ * Benchmark baselines (host build, ns per operation)
+ *
+ * Measured on the team's x86 build machine with -O2. A bench fails
+ * loudly when it exceeds its baseline by more than BENCH_MARGIN, so
+ * regressions in the hot paths surface before they ship. Re-baseline
+ * deliberately (and in its own commit) when a slowdown is accepted.
+ */
+
+#ifndef BENCH_BASELINES_H
+#define BENCH_BASELINES_H
+
+// Allowed slack over baseline before a bench is declared a regression
+// (covers machine-to-machine variance in CI)
+#define BENCH_MARGIN 4.0
+
+#define BASELINE_DELTA_MAGNITUDE_NS     8.0
+#define BASELINE_EXTRACT_MAGNITUDES_NS  250.0
+#define BASELINE_HISTORY_PUSH_NS        18.0
+#define BASELINE_HISTORY_WINDOW_NS      70.0
+#define BASELINE_ENCODE_BATCH_NS        220.0
+#define BASELINE_DECODE_BATCH_NS        30.0
+#define BASELINE_DTW_MATCH_NS           600.0
+#define BASELINE_CONTROL_POLICY_NS      10.0
+#define BASELINE_BRIDGE_FRAME_NS        1200.0
+#define BASELINE_ENHANCED_INPUT_NS      60.0
+
+#endif // BENCH_BASELINES_H
@@ -0,0 +1,271 @@
+/*
+ * Microbenchmark suite for the bridge hot paths (make bench)
+ *
+ * Drives the gesture kernel, input history, wire protocol and the
+ * full frame loop over synthetic workloads and reports per-operation
+ * cost: nanoseconds here on the host, time-base ticks if ever built
+ * for Gekko (gettime() is the clock on both). Results are compared
+ * against the checked-in baselines in bench_baselines.h; exceeding a
+ * baseline by more than BENCH_MARGIN fails the run.
+ *
+ * analyze_gesture_pattern() and process_ai_locally() are static
+ * internals; their cost is covered by the bridge_frame and
+ * enhanced_input benches, which go through the public entry points.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wii_interface.h"
+#include "game_state.h"
+#include "ai_bridge.h"
+#include "ai_protocol.h"
+#include "gesture_simd.h"
+#include "gesture_dtw.h"
+#include "ai_control.h"
+#include "input_history.h"
+#include "host_sim.h"
+#include "bench_baselines.h"
+
+// Game-side AI hooks, needed only to link
+void update_npc_behavior_for_player(WiiPlayer* player) { (void)player; }
+void adjust_global_difficulty(void) {}
+bool generate_dynamic_content_step(u32 step) { (void)step; return true; }
+
+static int failures = 0;
+
+// Sink to keep the optimizer from eliding measured work
+static volatile float sink_f;
+static volatile int sink_i;
+
+/*
+ * Measure fn over iters iterations; returns ns (host) per op
+ */
+static void bench_report(const char* name, double ns_per_op, double baseline) {
+    const char* verdict = "ok";
+    if (ns_per_op > baseline * BENCH_MARGIN) {
+        verdict = "REGRESSION";
+        failures++;
+    }
+    printf("%-24s %10.1f ns/op   (baseline %8.1f)  %s\n",
+           name, ns_per_op, baseline, verdict);
+}
+
+static double time_loop(void (*fn)(void), int iters) {
+    // Warm up caches and branch predictors
+    for (int i = 0; i < iters / 10 + 1; i++) fn();
+
+    u64 start = gettime();
+    for (int i = 0; i < iters; i++) fn();
+    u64 end = gettime();
+
+    return (double)(end - start) / (double)iters;
+}
+
+/*
+ * Synthetic fixtures
+ */
+static GestureSample sample_a, sample_b;
+static GestureBuffer bench_buffer;
+static InputHistory bench_history;
+static InputSnapshot bench_snapshot;
+static AIBatchRequest bench_batch;
+static u8 frame_buf[AI_PROTO_MAX_BATCH_REQUEST_SIZE];
+static u8 response_frame[AI_PROTO_MAX_BATCH_RESPONSE_SIZE];
+static int response_frame_len;
+
+static void setup_fixtures(void) {
+    sample_a.accel_x = 0.1f; sample_a.accel_y = -0.4f; sample_a.accel_z = 0.9f;
+    sample_b.accel_x = 0.7f; sample_b.accel_y = 0.2f; sample_b.accel_z = -0.3f;
+
+    memset(&bench_buffer, 0, sizeof(bench_buffer));
+    for (int i = 0; i < GESTURE_BUFFER_SIZE; i++) {
+        GestureSample* s = &bench_buffer.samples[i];
+        s->accel_x = (float)(i % 7) * 0.2f;
+        s->accel_y = (float)(i % 5) * 0.3f;
+        s->accel_z = (float)(i % 3) * 0.4f;
+    }
+    bench_buffer.sample_count = GESTURE_BUFFER_SIZE;
+
+    memset(&bench_history, 0, sizeof(bench_history));
+    memset(&bench_snapshot, 0, sizeof(bench_snapshot));
+    bench_snapshot.accel.x = 0.5f;
+    bench_snapshot.ir.valid = true;
+    bench_snapshot.gyro.valid = true;
+
+    // Full 4-player batch with maximum input windows
+    memset(&bench_batch, 0, sizeof(bench_batch));
+    bench_batch.timestamp = gettime();
+    bench_batch.player_count = MAX_PLAYERS;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        bench_batch.players[i].player_id = i;
+        bench_batch.players[i].input_count = AI_REQUEST_MAX_INPUTS;
+    }
+
+    // A matching 4-player response frame for the decode bench,
+    // hand-assembled at the documented offsets
+    memset(response_frame, 0, sizeof(response_frame));
+    response_frame[0] = 0x57; response_frame[1] = 0x42;  // magic LE
+    response_frame[2] = AI_PROTO_VERSION;
+    response_frame[3] = AI_PKT_BATCH_RESPONSE;
+    int payload = 4 + MAX_PLAYERS * AI_PROTO_RESPONSE_SIZE;
+    response_frame[8] = (u8)(payload & 0xFF);
+    response_frame[9] = (u8)(payload >> 8);
+    response_frame[AI_PROTO_HEADER_SIZE] = MAX_PLAYERS;
+    response_frame_len = AI_PROTO_HEADER_SIZE + payload;
+}
+
+/*
+ * Bench bodies
+ */
+static void bench_delta_magnitude(void) {
+    sink_f = gesture_delta_magnitude(&sample_a, &sample_b);
+}
+
+static void bench_extract_magnitudes(void) {
+    float out[GESTURE_BUFFER_SIZE];
+    sink_i = gesture_extract_magnitudes(&bench_buffer, out, GESTURE_BUFFER_SIZE);
+}
+
+static void bench_history_push(void) {
+    input_history_push(&bench_history, &bench_snapshot);
+}
+
+static void bench_history_window(void) {
+    InputSnapshot window[AI_REQUEST_MAX_INPUTS];
+    sink_i = input_history_window(&bench_history, AI_REQUEST_MAX_INPUTS, window);
+}
+
+static void bench_encode_batch(void) {
+    sink_i = ai_protocol_encode_batch_request(&bench_batch, 1, frame_buf,
+                                              sizeof(frame_buf));
+}
+
+static void bench_dtw_match(void) {
+    // Swing-shaped window: the matcher walks the full library
+    static const float swing_window[12] = {
+        0.1f, 0.25f, 0.6f, 1.0f, 1.5f, 1.8f,
+        1.85f, 1.6f, 1.1f, 0.6f, 0.3f, 0.1f
+    };
+    float confidence;
+    sink_i = gesture_dtw_match(swing_window, 12, &confidence);
+    sink_f = confidence;
+}
+
+static void bench_decode_batch(void) {
+    AIBatchResponse decoded;
+    sink_i = ai_protocol_decode_batch_response(response_frame,
+                                               response_frame_len,
+                                               &decoded, NULL);
+}
+
+static void bench_control_policy(void) {
+    AIControlPolicy policy;
+    ai_control_policy_fixed(0.7f, 0.6f, 0.45f, 0.5f, &policy);
+    sink_f = policy.difficulty_adjustment;
+}
+
+/*
+ * Cross-check the fixed-point controller against the float reference
+ * across the whole input range. Q16.16 resolves ~1.5e-5; allow a few
+ * LSBs of rounding slack.
+ */
+static int verify_control_policy(void) {
+    int mismatches = 0;
+    for (float c = 0.0f; c <= 1.0f; c += 0.05f) {
+        for (float k = 0.0f; k <= 1.0f; k += 0.05f) {
+            for (float d = 0.1f; d <= 1.0f; d += 0.05f) {
+                AIControlPolicy ref, fix;
+                ai_control_policy_float(c, 0.5f, k, d, &ref);
+                ai_control_policy_fixed(c, 0.5f, k, d, &fix);
+                if (fabsf(ref.difficulty_adjustment -
+                          fix.difficulty_adjustment) > 1e-4f ||
+                    fabsf(ref.sensitivity_multiplier -
+                          fix.sensitivity_multiplier) > 1e-4f ||
+                    fabsf(ref.npc_aggression - fix.npc_aggression) > 1e-4f ||
+                    fabsf(ref.npc_intelligence -
+                          fix.npc_intelligence) > 1e-4f) {
+                    mismatches++;
+                }
+                if (fabsf(ai_control_clamp_difficulty_float(d + 0.5f) -
+                          ai_control_clamp_difficulty_fixed(d + 0.5f)) >
+                    1e-4f) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    printf("%-24s %s\n", "control_fixed_vs_float",
+           mismatches ? "MISMATCH" : "agree");
+    return mismatches;
+}
+
+static void bench_bridge_frame(void) {
+    wii_ai_bridge_update();
+}
+
+static void bench_enhanced_input(void) {
+    WiiInput input = wii_ai_get_enhanced_input(0);
+    sink_i = (int)input.predicted_gesture;
+}
+
+int main(int argc, char** argv) {
+    int iters = 100000;
+    if (argc > 1) iters = atoi(argv[1]);
+
+    setup_fixtures();
+
+    printf("Bridge microbenchmarks (%d iterations each)\n\n", iters);
+
+    bench_report("delta_magnitude",
+                 time_loop(bench_delta_magnitude, iters),
+                 BASELINE_DELTA_MAGNITUDE_NS);
+    bench_report("extract_magnitudes",
+                 time_loop(bench_extract_magnitudes, iters),
+                 BASELINE_EXTRACT_MAGNITUDES_NS);
+    bench_report("history_push",
+                 time_loop(bench_history_push, iters),
+                 BASELINE_HISTORY_PUSH_NS);
+    bench_report("history_window",
+                 time_loop(bench_history_window, iters),
+                 BASELINE_HISTORY_WINDOW_NS);
+    bench_report("encode_batch",
+                 time_loop(bench_encode_batch, iters),
+                 BASELINE_ENCODE_BATCH_NS);
+    bench_report("decode_batch",
+                 time_loop(bench_decode_batch, iters),
+                 BASELINE_DECODE_BATCH_NS);
+    bench_report("dtw_match",
+                 time_loop(bench_dtw_match, iters),
+                 BASELINE_DTW_MATCH_NS);
+    bench_report("control_policy",
+                 time_loop(bench_control_policy, iters),
+                 BASELINE_CONTROL_POLICY_NS);
+    failures += verify_control_policy();
+
+    // Full frame loop through the public API (covers the static
+    // gesture analysis and local AI paths)
+    if (wii_ai_bridge_init() != 0) {
+        fprintf(stderr, "Bridge init failed\n");
+        return 1;
+    }
+    wii_ai_set_game_type(GAME_TYPE_SPORTS);
+
+    bench_report("bridge_frame",
+                 time_loop(bench_bridge_frame, iters / 10),
+                 BASELINE_BRIDGE_FRAME_NS);
+    bench_report("enhanced_input",
+                 time_loop(bench_enhanced_input, iters),
+                 BASELINE_ENHANCED_INPUT_NS);
+
+    wii_ai_bridge_cleanup();
+
+    if (failures) {
+        printf("\n%d benchmark(s) regressed past baseline\n", failures);
+        return 1;
+    }
+    printf("\nAll benchmarks within baseline\n");
+    return 0;
+}
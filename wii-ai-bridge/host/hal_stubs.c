@@ -0,0 +1,221 @@
+/*
+ * Host stub HAL implementation
+ *
+ * WPAD data comes from a replayed trace when one is loaded, otherwise
+ * from a synthetic motion generator that sweeps through idle, point
+ * and swing intensity ranges so every classification path gets
+ * exercised. Network and threading stubs delegate to POSIX.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <gccore.h>
+#include <wiiuse/wpad.h>
+#include <network.h>
+
+#include "host_sim.h"
+
+/*
+ * Time
+ */
+void VIDEO_Init(void) {}
+
+u64 gettime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+u32 diff_usec(u64 start, u64 end) {
+    return (u32)((end - start) / 1000ull);
+}
+
+/*
+ * Threads
+ */
+s32 LWP_CreateThread(lwp_t* thread, void* (*entry)(void*), void* arg,
+                     void* stackbase, u32 stack_size, u8 prio) {
+    (void)stackbase;
+    (void)stack_size;
+    (void)prio;
+    return pthread_create(thread, NULL, entry, arg) == 0 ? 0 : -1;
+}
+
+s32 LWP_JoinThread(lwp_t thread, void** value_ptr) {
+    return pthread_join(thread, value_ptr) == 0 ? 0 : -1;
+}
+
+/*
+ * Network
+ */
+s32 net_init(void) { return 0; }
+
+s32 net_socket(u32 domain, u32 type, u32 protocol) {
+    return socket(domain, type, protocol);
+}
+
+s32 net_close(s32 fd) { return close(fd); }
+
+s32 net_fcntl(s32 fd, u32 cmd, u32 flags) {
+    return fcntl(fd, cmd, flags);
+}
+
+s32 net_sendto(s32 fd, const void* data, s32 len, u32 flags,
+               struct sockaddr* to, s32 tolen) {
+    return (s32)sendto(fd, data, len, flags, to, tolen);
+}
+
+s32 net_recvfrom(s32 fd, void* mem, s32 len, u32 flags,
+                 struct sockaddr* from, socklen_t* fromlen) {
+    return (s32)recvfrom(fd, mem, len, flags, from, fromlen);
+}
+
+/*
+ * WPAD replay
+ */
+#define SIM_MAX_CHANNELS 4
+
+static WPADData channel_data[SIM_MAX_CHANNELS];
+static bool channel_connected[SIM_MAX_CHANNELS] = { true, false, false, false };
+static u32 scan_count = 0;
+
+static HostTraceRecord* trace_records = NULL;
+static int trace_count = 0;
+static int trace_cursor = 0;
+
+s32 WPAD_Init(void) { return 0; }
+void WPAD_SetDataFormat(s32 chan, s32 fmt) { (void)chan; (void)fmt; }
+
+s32 WPAD_Probe(s32 chan, u32* type) {
+    if (type) *type = 0;
+    if (chan < 0 || chan >= SIM_MAX_CHANNELS || !channel_connected[chan]) {
+        return WPAD_ERR_NO_CONTROLLER;
+    }
+    return WPAD_ERR_NONE;
+}
+
+WPADData* WPAD_Data(s32 chan) {
+    if (chan < 0 || chan >= SIM_MAX_CHANNELS) return NULL;
+    return &channel_data[chan];
+}
+
+/*
+ * Synthetic motion: a slow intensity sweep so idle, point and swing
+ * classifications all occur during a default run
+ */
+static void synthesize_channel(int chan, u32 t) {
+    WPADData* data = &channel_data[chan];
+    // Fast phase so inter-sample deltas at 200 Hz span the idle,
+    // point and swing intensity bands as the envelope sweeps
+    float phase = (float)t * 0.9f + (float)chan;
+    float intensity = 1.2f * (0.5f + 0.5f * sinf((float)t * 0.008f));
+
+    data->btns_h = (t / 120) % 2 ? 0x0008 : 0;  // periodic A press
+    data->btns_d = 0;
+    data->btns_u = 0;
+    data->accel.x = intensity * sinf(phase);
+    data->accel.y = intensity * cosf(phase * 1.3f);
+    data->accel.z = intensity * sinf(phase * 0.7f);
+    data->ir.valid = 1;
+    data->ir.x = 320.0f + 200.0f * sinf(phase * 0.1f);
+    data->ir.y = 240.0f + 150.0f * cosf(phase * 0.1f);
+    data->ir.angle = 0.0f;
+    data->exp.type = WPAD_EXP_MOTION_PLUS;
+    data->exp.mp.pitch = 10.0f * sinf(phase);
+    data->exp.mp.roll = 10.0f * cosf(phase);
+    data->exp.mp.yaw = 5.0f * sinf(phase * 0.5f);
+}
+
+static void replay_record(const HostTraceRecord* rec) {
+    if (rec->channel >= SIM_MAX_CHANNELS) return;
+
+    WPADData* data = &channel_data[rec->channel];
+    channel_connected[rec->channel] = true;
+    data->btns_h = rec->buttons;
+    data->accel.x = rec->accel[0];
+    data->accel.y = rec->accel[1];
+    data->accel.z = rec->accel[2];
+    data->exp.type = rec->gyro_valid ? WPAD_EXP_MOTION_PLUS : WPAD_EXP_NONE;
+    data->exp.mp.pitch = rec->gyro[0];
+    data->exp.mp.roll = rec->gyro[1];
+    data->exp.mp.yaw = rec->gyro[2];
+}
+
+s32 WPAD_ScanPads(void) {
+    scan_count++;
+
+    if (trace_records) {
+        // One record per connected channel per scan; the trace loops
+        for (int i = 0; i < SIM_MAX_CHANNELS && trace_count > 0; i++) {
+            replay_record(&trace_records[trace_cursor]);
+            trace_cursor = (trace_cursor + 1) % trace_count;
+        }
+    } else {
+        for (int i = 0; i < SIM_MAX_CHANNELS; i++) {
+            if (channel_connected[i]) {
+                synthesize_channel(i, scan_count);
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Queued-event drain: the real WPAD buffers device reports between
+ * drains, so model a device rate above the 200 Hz drain rate by
+ * producing a couple of reports per channel per call
+ */
+#define SIM_EVENTS_PER_DRAIN 2
+
+void WPAD_ReadPending(s32 chan, WPADDataCallback datacb) {
+    for (int e = 0; e < SIM_EVENTS_PER_DRAIN; e++) {
+        WPAD_ScanPads();
+        for (int i = 0; i < SIM_MAX_CHANNELS; i++) {
+            if (chan != WPAD_CHAN_ALL && chan != i) continue;
+            if (!channel_connected[i]) continue;
+            if (datacb) datacb(i, &channel_data[i]);
+        }
+    }
+}
+
+int host_sim_load_trace(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Could not open trace: %s\n", path);
+        return -1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    int count = (int)(size / sizeof(HostTraceRecord));
+    trace_records = malloc(count * sizeof(HostTraceRecord));
+    if (!trace_records || fread(trace_records, sizeof(HostTraceRecord),
+                                count, f) != (size_t)count) {
+        fclose(f);
+        free(trace_records);
+        trace_records = NULL;
+        return -1;
+    }
+    fclose(f);
+
+    trace_count = count;
+    trace_cursor = 0;
+    printf("Loaded trace: %d records\n", count);
+    return count;
+}
+
+void host_sim_set_connected(int channel, bool connected) {
+    if (channel >= 0 && channel < SIM_MAX_CHANNELS) {
+        channel_connected[channel] = connected;
+    }
+}
+
+u32 host_sim_scan_count(void) {
+    return scan_count;
+}
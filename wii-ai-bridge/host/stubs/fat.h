@@ -0,0 +1,12 @@
+/*
+ * Host stub for libfat <fat.h> — the host filesystem is always there.
+ */
+
+#ifndef HOST_STUB_FAT_H
+#define HOST_STUB_FAT_H
+
+#include <stdbool.h>
+
+static inline bool fatInitDefault(void) { return true; }
+
+#endif // HOST_STUB_FAT_H
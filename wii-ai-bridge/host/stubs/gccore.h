@@ -0,0 +1,47 @@
+/*
+ * Host stub for libogc <gccore.h>
+ *
+ * Just enough of the libogc surface for the bridge sources to build
+ * natively (make host), so the hot paths can run under perf, valgrind
+ * and sanitizers. Threading maps onto pthreads, time onto the
+ * monotonic clock.
+ */
+
+#ifndef HOST_STUB_GCCORE_H
+#define HOST_STUB_GCCORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// libogc integer types
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef volatile u32 vu32;
+typedef float f32;
+typedef double f64;
+
+#define ATTRIBUTE_ALIGN(x) __attribute__((aligned(x)))
+
+// Video (no-op on host)
+void VIDEO_Init(void);
+
+// Monotonic tick counter (nanoseconds on host)
+u64 gettime(void);
+u32 diff_usec(u64 start, u64 end);
+
+// lwp threads -> pthreads
+typedef pthread_t lwp_t;
+#define LWP_THREAD_NULL ((lwp_t)0)
+
+s32 LWP_CreateThread(lwp_t* thread, void* (*entry)(void*), void* arg,
+                     void* stackbase, u32 stack_size, u8 prio);
+s32 LWP_JoinThread(lwp_t thread, void** value_ptr);
+
+#endif // HOST_STUB_GCCORE_H
@@ -0,0 +1,29 @@
+/*
+ * Host simulation controls
+ *
+ * Extra knobs the stub HAL exposes to the simulator driver: trace
+ * replay and channel connection state. Not part of the libogc
+ * surface.
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <gccore.h>
+#include "trace_recorder.h"
+
+// One replayed input record, consumed one per WPAD_ScanPads() per
+// channel. Traces are what the in-bridge recorder writes: flat
+// little-endian arrays of TraceRecord.
+typedef TraceRecord HostTraceRecord;
+
+// Load a recorded input trace; returns the record count or -1.
+int host_sim_load_trace(const char* path);
+
+// Mark a channel as connected/disconnected.
+void host_sim_set_connected(int channel, bool connected);
+
+// Number of WPAD scans performed so far.
+u32 host_sim_scan_count(void);
+
+#endif // HOST_SIM_H
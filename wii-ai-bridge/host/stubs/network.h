@@ -0,0 +1,32 @@
+/*
+ * Host stub for libogc <network.h>
+ *
+ * net_* calls map straight onto the POSIX socket API so the host
+ * build exercises the real encode/send/poll/decode path against a
+ * local AI engine if one is listening.
+ */
+
+#ifndef HOST_STUB_NETWORK_H
+#define HOST_STUB_NETWORK_H
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gccore.h>
+
+// libogc's IOS non-blocking flag; mapped to O_NONBLOCK on host
+#define IOS_O_NONBLOCK O_NONBLOCK
+
+s32 net_init(void);
+s32 net_socket(u32 domain, u32 type, u32 protocol);
+s32 net_close(s32 fd);
+s32 net_fcntl(s32 fd, u32 cmd, u32 flags);
+s32 net_sendto(s32 fd, const void* data, s32 len, u32 flags,
+               struct sockaddr* to, s32 tolen);
+s32 net_recvfrom(s32 fd, void* mem, s32 len, u32 flags,
+                 struct sockaddr* from, socklen_t* fromlen);
+
+#endif // HOST_STUB_NETWORK_H
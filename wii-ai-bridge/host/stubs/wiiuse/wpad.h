@@ -0,0 +1,63 @@
+/*
+ * Host stub for <wiiuse/wpad.h>
+ *
+ * WPAD calls are served from a replay source: either a recorded input
+ * trace loaded via host_sim.h or a built-in synthetic motion
+ * generator. Field names and shapes match what the bridge reads.
+ */
+
+#ifndef HOST_STUB_WPAD_H
+#define HOST_STUB_WPAD_H
+
+#include <gccore.h>
+
+#define WPAD_CHAN_ALL (-1)
+#define WPAD_FMT_BTNS_ACC_IR 2
+#define WPAD_ERR_NONE 0
+#define WPAD_ERR_NO_CONTROLLER (-1)
+#define WPAD_EXP_NONE 0
+#define WPAD_EXP_MOTION_PLUS 5
+
+typedef struct {
+    float x;
+    float y;
+    float z;
+} wpad_accel_t;
+
+typedef struct {
+    int valid;
+    float x;
+    float y;
+    float angle;
+} wpad_ir_t;
+
+typedef struct {
+    float pitch;
+    float roll;
+    float yaw;
+} wpad_mp_t;
+
+typedef struct {
+    int type;
+    wpad_mp_t mp;
+} wpad_exp_t;
+
+typedef struct {
+    u32 btns_h;
+    u32 btns_d;
+    u32 btns_u;
+    wpad_accel_t accel;
+    wpad_ir_t ir;
+    wpad_exp_t exp;
+} WPADData;
+
+typedef void (*WPADDataCallback)(s32 chan, const WPADData* data);
+
+s32 WPAD_Init(void);
+void WPAD_SetDataFormat(s32 chan, s32 fmt);
+s32 WPAD_ScanPads(void);
+s32 WPAD_Probe(s32 chan, u32* type);
+WPADData* WPAD_Data(s32 chan);
+void WPAD_ReadPending(s32 chan, WPADDataCallback datacb);
+
+#endif // HOST_STUB_WPAD_H
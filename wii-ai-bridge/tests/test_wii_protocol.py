@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Round-trip and validation tests for the binary bridge protocol.
+
+Builds a request frame the same way wii/ai_protocol.c does (byte
+offsets hardcoded independently of wii_protocol's formats) and checks
+the Python decoder reads every field back, plus response encoding and
+malformed-frame rejection.
+"""
+
+import os
+import struct
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, "..", "core"))
+
+import wii_protocol
+
+failures = []
+
+
+def check(name, ok, detail=""):
+    print(("PASS " if ok else "FAIL ") + name + ("  " + detail if detail else ""))
+    if not ok:
+        failures.append(name)
+
+
+def build_request_frame(sequence=7, input_count=2):
+    """Hand-build a v2 request frame at the documented byte offsets."""
+    payload = bytearray(72 + input_count * 48)
+    struct.pack_into("<BBBB", payload, 0, 3, input_count, 2, 1)
+    struct.pack_into("<Q", payload, 4, 123456789)
+    struct.pack_into("<B", payload, 12, 2)  # GESTURE_SWING
+    struct.pack_into("<ff", payload, 16, 0.9, 0.8)
+    struct.pack_into("<fff", payload, 24, 0.55, 0.1, 0.05)
+    struct.pack_into("<IIf", payload, 36, 4, 6000, 0.5)
+    struct.pack_into("<4i", payload, 48, 10, 20, -1, 0)
+    for i in range(input_count):
+        off = 72 + i * 48
+        struct.pack_into("<IIB", payload, off, 0x8, 0x4, 0x03)
+        struct.pack_into("<I", payload, off + 12, i * 16)
+        struct.pack_into("<8f", payload, off + 16,
+                         0.1, 0.2, 0.3, 400.0, 300.0, 1.0, 2.0, 3.0)
+    header = struct.pack("<HBBIHH", 0x4257, 2, 1, sequence, len(payload), 0)
+    return bytes(header) + bytes(payload)
+
+
+# Request decode
+frame = build_request_frame()
+req = wii_protocol.decode_request(frame)
+check("sequence", req.sequence == 7)
+check("player_id", req.player_id == 3)
+check("game_type", req.game_type == 2)
+check("ai_enabled", req.ai_enabled is True)
+check("timestamp", req.timestamp == 123456789)
+check("gesture", req.gesture_type == 2 and abs(req.gesture_intensity - 0.9) < 1e-6)
+check("profile", abs(req.skill_level - 0.55) < 1e-6)
+check("scores", req.player_scores == (10, 20, -1, 0))
+check("input_count", len(req.inputs) == 2)
+check("snapshot_flags", req.inputs[0].ir_valid and req.inputs[0].gyro_valid)
+check("snapshot_accel", abs(req.inputs[1].accel[2] - 0.3) < 1e-6)
+check("snapshot_delta", req.inputs[1].timestamp_delta == 16)
+
+# Response round trip through the documented layout
+resp = wii_protocol.BridgeResponse(
+    player_id=3, timestamp=123456789,
+    difficulty_adjustment=-0.02, learning_rate_adjustment=0.1,
+    enhancement_enabled=True, sensitivity_multiplier=1.1,
+    npc_aggression=0.5, npc_intelligence=0.65)
+encoded = wii_protocol.encode_response(resp, sequence=7)
+check("response_size", len(encoded) == 12 + 32, str(len(encoded)))
+magic, version, pkt_type, seq, plen, _ = struct.unpack_from("<HBBIHH", encoded, 0)
+check("response_header",
+      (magic, version, pkt_type, seq, plen) == (0x4257, 2, 2, 7, 32))
+pid, flags, _, ts, dadj, lra, sens, aggr, intel = struct.unpack_from(
+    "<BBHQfffff", encoded, 12)
+check("response_fields",
+      pid == 3 and flags == 1 and ts == 123456789 and
+      abs(dadj + 0.02) < 1e-6 and abs(intel - 0.65) < 1e-6)
+
+# Malformed frames are rejected
+for name, bad in [
+    ("bad_magic", b"\x00\x00" + frame[2:]),
+    ("bad_version", frame[:2] + b"\x09" + frame[3:]),
+    ("truncated", frame[:40]),
+    ("short_header", frame[:4]),
+    # Self-consistent header but payload shorter than the fixed block
+    ("short_payload",
+     struct.pack("<HBBIHH", 0x4257, 2, 1, 7, 16, 0) + bytes(16)),
+]:
+    try:
+        wii_protocol.decode_request(bad)
+        check(name, False, "accepted malformed frame")
+    except wii_protocol.ProtocolError:
+        check(name, True)
+
+# Batch request decode (shared block + two player slices; the first
+# window carries a full snapshot plus one packed delta)
+def build_batch_frame(sequence=9):
+    shared = struct.pack("<QBBBBIIf4i", 111, 1, 1, 2, 0, 3, 7500, 0.4,
+                         5, 6, 7, 8)
+    slices = b""
+    for pid, n_inputs in ((0, 2), (2, 0)):
+        slices += struct.pack("<BBBBfffff", pid, n_inputs, 1, 0,
+                              0.5, 0.7, 0.6, 0.1, 0.05)
+        if n_inputs > 0:
+            snap = bytearray(48)
+            struct.pack_into("<IIB", snap, 0, 0x1, 0x0, 0x01)
+            struct.pack_into("<8f", snap, 16, 1, 2, 3, 4, 5, 6, 7, 8)
+            slices += bytes(snap)
+            # Packed delta: narrow accel, edge buttons, narrow IR
+            slices += struct.pack("<BI3bI2b", 0x0A, 42, 64, -32, 0,
+                                  0x10, 2, -4)
+    payload = shared + slices
+    header = struct.pack("<HBBIHH", 0x4257, 2, 3, sequence, len(payload), 0)
+    return header + payload
+
+
+batch = wii_protocol.decode_batch_request(build_batch_frame())
+check("batch_sequence", batch.sequence == 9)
+check("batch_game", batch.game_type == 1 and batch.frame_count == 7500)
+check("batch_scores", batch.player_scores == (5, 6, 7, 8))
+check("batch_players", [p.player_id for p in batch.players] == [0, 2])
+check("batch_inputs", len(batch.players[0].inputs) == 2 and
+      not batch.players[1].inputs)
+check("batch_slice", abs(batch.players[1].skill_level - 0.6) < 1e-6)
+
+# Packed snapshot reconstruction against its predecessor
+packed = batch.players[0].inputs[1]
+check("packed_ts", packed.timestamp_delta == 42)
+check("packed_accel", abs(packed.accel[0] - 2.0) < 1e-6 and
+      abs(packed.accel[1] - 1.5) < 1e-6 and
+      abs(packed.accel[2] - 3.0) < 1e-6)
+check("packed_buttons", packed.buttons_held == 0x1 and
+      packed.buttons_pressed == 0x10)
+check("packed_ir", packed.ir_valid and
+      abs(packed.ir[0] - 5.0) < 1e-6 and abs(packed.ir[1] - 3.0) < 1e-6)
+check("packed_gyro", not packed.gyro_valid)
+
+# A packed snapshot promising more bytes than the payload has is
+# rejected
+good = build_batch_frame()
+truncated = bytearray(good[:-3])  # drop the packed snapshot's tail
+struct.pack_into("<H", truncated, 8, len(good) - 12 - 3)
+try:
+    wii_protocol.decode_batch_request(bytes(truncated))
+    check("packed_truncated", False, "accepted short packed snapshot")
+except wii_protocol.ProtocolError:
+    check("packed_truncated", True)
+
+# Delta batch decode: only dirty fields travel, the rest comes from
+# the base batch (or Wii-side defaults without one)
+def build_delta_frame(sequence=10, dirty=0x48, player_count=1):
+    fixed = struct.pack("<QIBBH", 222, 7516, dirty, player_count, 0)
+    fields = b""
+    if dirty & 0x01:
+        fields += struct.pack("<B", 4)        # game_type
+    if dirty & 0x08:
+        fields += struct.pack("<f", 0.45)     # difficulty
+    if dirty & 0x40:
+        fields += struct.pack("<i", 99)       # score[2]
+    slices = struct.pack("<BBBBfffff", 1, 0, 2, 0, 0.9, 0.8, 0.6, 0.1, 0.05)
+    payload = fixed + fields + slices[:player_count * 24]
+    header = struct.pack("<HBBIHH", 0x4257, 2, 5, sequence, len(payload), 0)
+    return header + payload
+
+
+delta = wii_protocol.decode_batch_delta(build_delta_frame(), base=batch)
+check("delta_sequence", delta.sequence == 10 and delta.frame_count == 7516)
+check("delta_changed", abs(delta.difficulty - 0.45) < 1e-6 and
+      delta.player_scores == (5, 6, 99, 8))
+check("delta_inherited", delta.game_type == 1 and delta.current_level == 3)
+check("delta_players", [p.player_id for p in delta.players] == [1])
+
+# Without a base the Wii-side initial state fills the gaps
+delta = wii_protocol.decode_batch_delta(build_delta_frame(dirty=0x09))
+check("delta_no_base", delta.game_type == 4 and
+      abs(delta.difficulty - 0.45) < 1e-6 and
+      delta.player_scores == (0, 0, 0, 0))
+
+# Dirty mask promising more bytes than the payload has is rejected
+try:
+    wii_protocol.decode_batch_delta(build_delta_frame(dirty=0xFF))
+    check("delta_truncated", False, "accepted short delta")
+except wii_protocol.ProtocolError:
+    check("delta_truncated", True)
+
+# Batch response encoding
+encoded = wii_protocol.encode_batch_response([resp, resp], sequence=9)
+check("batch_response_size", len(encoded) == 12 + 4 + 2 * 32)
+magic, version, pkt_type, seq, plen, _ = struct.unpack_from("<HBBIHH", encoded, 0)
+check("batch_response_header",
+      (magic, version, pkt_type, seq, plen) == (0x4257, 2, 4, 9, 68))
+check("batch_response_count", encoded[12] == 2)
+check("packet_type_peek",
+      wii_protocol.packet_type(build_batch_frame()) == 3 and
+      wii_protocol.packet_type(frame) == 1)
+
+print()
+if failures:
+    print(f"{len(failures)} test(s) failed")
+    sys.exit(1)
+print("All protocol tests passed")
@@ -0,0 +1,65 @@
+/*
+ * Controller policy implementations
+ *
+ * The two variants must stay in lockstep: any constant that changes
+ * in one changes in the other, and the host bench cross-checks them
+ * on every run. The policy itself matches the server's response
+ * model (target 60% success rate) so a locally produced answer is
+ * indistinguishable from a round trip.
+ */
+
+#include <gccore.h>
+
+#include "ai_control.h"
+
+void ai_control_policy_float(float gesture_confidence, float consistency,
+                             float skill_level, float difficulty,
+                             AIControlPolicy* out) {
+    float performance = (gesture_confidence + consistency) * 0.5f;
+    out->difficulty_adjustment = (performance - 0.6f) * 0.1f;
+    out->sensitivity_multiplier = 1.0f + (0.5f - skill_level) * 0.2f;
+    out->npc_aggression = 0.3f + difficulty * 0.4f;
+    out->npc_intelligence = 0.5f + skill_level * 0.3f;
+}
+
+// The same constants as Q16.16 reciprocals/gains, computed once at
+// compile time
+#define Q16_HALF       Q16(0.5f)   // 1/2 performance blend
+#define Q16_TARGET     Q16(0.6f)   // 60% success target
+#define Q16_DIFF_GAIN  Q16(0.1f)   // 1/10 adjustment gain
+#define Q16_SENS_GAIN  Q16(0.2f)   // 1/5 sensitivity gain
+#define Q16_AGGR_BASE  Q16(0.3f)
+#define Q16_AGGR_GAIN  Q16(0.4f)
+#define Q16_INTEL_BASE Q16(0.5f)
+#define Q16_INTEL_GAIN Q16(0.3f)
+
+void ai_control_policy_fixed(float gesture_confidence, float consistency,
+                             float skill_level, float difficulty,
+                             AIControlPolicy* out) {
+    q16_t confidence_q = q16_from_float(gesture_confidence);
+    q16_t consistency_q = q16_from_float(consistency);
+    q16_t skill_q = q16_from_float(skill_level);
+    q16_t difficulty_q = q16_from_float(difficulty);
+
+    q16_t performance = q16_mul(confidence_q + consistency_q, Q16_HALF);
+    q16_t adjustment = q16_mul(performance - Q16_TARGET, Q16_DIFF_GAIN);
+    q16_t sensitivity = Q16_ONE + q16_mul(Q16_HALF - skill_q, Q16_SENS_GAIN);
+    q16_t aggression = Q16_AGGR_BASE + q16_mul(difficulty_q, Q16_AGGR_GAIN);
+    q16_t intelligence = Q16_INTEL_BASE + q16_mul(skill_q, Q16_INTEL_GAIN);
+
+    out->difficulty_adjustment = q16_to_float(adjustment);
+    out->sensitivity_multiplier = q16_to_float(sensitivity);
+    out->npc_aggression = q16_to_float(aggression);
+    out->npc_intelligence = q16_to_float(intelligence);
+}
+
+float ai_control_clamp_difficulty_float(float difficulty) {
+    if (difficulty < 0.1f) return 0.1f;
+    if (difficulty > 1.0f) return 1.0f;
+    return difficulty;
+}
+
+float ai_control_clamp_difficulty_fixed(float difficulty) {
+    q16_t d = q16_clamp(q16_from_float(difficulty), Q16(0.1f), Q16_ONE);
+    return q16_to_float(d);
+}
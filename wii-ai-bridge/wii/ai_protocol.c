@@ -0,0 +1,514 @@
+/*
+ * Binary wire protocol implementation
+ *
+ * Straight-line byte stores with no intermediate formatting pass. All
+ * multi-byte fields are little-endian on the wire regardless of host
+ * byte order. Layout changes must bump AI_PROTO_VERSION and be
+ * mirrored in core/wii_protocol.py.
+ */
+
+#include <string.h>
+
+#include "ai_protocol.h"
+#include "game_state.h"
+
+/*
+ * Little-endian store/load helpers
+ */
+static inline void put_u16(u8* p, u16 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)(v >> 8);
+}
+
+static inline void put_u32(u8* p, u32 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)((v >> 8) & 0xFF);
+    p[2] = (u8)((v >> 16) & 0xFF);
+    p[3] = (u8)((v >> 24) & 0xFF);
+}
+
+static inline void put_u64(u8* p, u64 v) {
+    put_u32(p, (u32)(v & 0xFFFFFFFF));
+    put_u32(p + 4, (u32)(v >> 32));
+}
+
+static inline void put_f32(u8* p, float v) {
+    u32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_u32(p, bits);
+}
+
+static inline u16 get_u16(const u8* p) {
+    return (u16)(p[0] | (p[1] << 8));
+}
+
+static inline u32 get_u32(const u8* p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static inline u64 get_u64(const u8* p) {
+    return (u64)get_u32(p) | ((u64)get_u32(p + 4) << 32);
+}
+
+static inline float get_f32(const u8* p) {
+    u32 bits = get_u32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+/*
+ * Write the fixed frame header
+ */
+static void write_header(u8* buf, u8 type, u32 sequence, u16 payload_len) {
+    put_u16(buf, AI_PROTO_MAGIC);
+    buf[2] = AI_PROTO_VERSION;
+    buf[3] = type;
+    put_u32(buf + 4, sequence);
+    put_u16(buf + 8, payload_len);
+    put_u16(buf + 10, 0);  // reserved
+}
+
+/*
+ * Encode one input snapshot (AI_PROTO_SNAPSHOT_SIZE bytes)
+ */
+static void encode_snapshot(u8* p, const InputSnapshot* snap, u64 base_time) {
+    u8 flags = 0;
+    if (snap->ir.valid) flags |= 0x01;
+    if (snap->gyro.valid) flags |= 0x02;
+
+    put_u32(p, snap->buttons_held);
+    put_u32(p + 4, snap->buttons_pressed);
+    p[8] = flags;
+    p[9] = 0;
+    put_u16(p + 10, 0);
+    // Delta against the request timestamp keeps this field at 32 bits
+    put_u32(p + 12, (u32)(base_time - snap->timestamp));
+    put_f32(p + 16, snap->accel.x);
+    put_f32(p + 20, snap->accel.y);
+    put_f32(p + 24, snap->accel.z);
+    put_f32(p + 28, snap->ir.x);
+    put_f32(p + 32, snap->ir.y);
+    put_f32(p + 36, snap->gyro.pitch);
+    put_f32(p + 40, snap->gyro.roll);
+    put_f32(p + 44, snap->gyro.yaw);
+}
+
+/*
+ * Quantize one field delta to s8; returns false when it overflows the
+ * scale and the field must travel absolute
+ */
+static bool quantize_delta(float curr, float prev, float scale, s8* out) {
+    float q = (curr - prev) / scale;
+    if (q > 127.0f || q < -127.0f) {
+        return false;
+    }
+    *out = (s8)(q < 0.0f ? q - 0.5f : q + 0.5f);
+    return true;
+}
+
+/*
+ * Encode one packed delta snapshot against its predecessor in the
+ * window (protocol v2, snapshots after the first in a batch slice).
+ * Returns the byte count written.
+ */
+static int encode_packed_snapshot(u8* p, const InputSnapshot* snap,
+                                  const InputSnapshot* prev, u64 base_time) {
+    u8* start = p;
+    u8 flags = 0;
+    s8 q[3];
+    p++;  // flags written last
+
+    put_u32(p, (u32)(base_time - snap->timestamp));
+    p += 4;
+
+    // Accel always travels: quantized deltas, absolute on overflow
+    if (quantize_delta(snap->accel.x, prev->accel.x, AI_PROTO_ACCEL_QUANT, &q[0]) &&
+        quantize_delta(snap->accel.y, prev->accel.y, AI_PROTO_ACCEL_QUANT, &q[1]) &&
+        quantize_delta(snap->accel.z, prev->accel.z, AI_PROTO_ACCEL_QUANT, &q[2])) {
+        p[0] = (u8)q[0]; p[1] = (u8)q[1]; p[2] = (u8)q[2];
+        p += 3;
+    } else {
+        flags |= AI_PROTO_PACKED_ACCEL_WIDE;
+        put_f32(p, snap->accel.x);
+        put_f32(p + 4, snap->accel.y);
+        put_f32(p + 8, snap->accel.z);
+        p += 12;
+    }
+
+    // Button words only when they carry information
+    if (snap->buttons_held != prev->buttons_held) {
+        flags |= AI_PROTO_PACKED_BTN_HELD;
+        put_u32(p, snap->buttons_held);
+        p += 4;
+    }
+    if (snap->buttons_pressed != 0) {
+        flags |= AI_PROTO_PACKED_BTN_EDGE;
+        put_u32(p, snap->buttons_pressed);
+        p += 4;
+    }
+
+    // IR and gyro are absent entirely while invalid; deltas need a
+    // valid predecessor to diff against
+    if (snap->ir.valid) {
+        flags |= AI_PROTO_PACKED_IR_VALID;
+        if (prev->ir.valid &&
+            quantize_delta(snap->ir.x, prev->ir.x, AI_PROTO_IR_QUANT, &q[0]) &&
+            quantize_delta(snap->ir.y, prev->ir.y, AI_PROTO_IR_QUANT, &q[1])) {
+            p[0] = (u8)q[0]; p[1] = (u8)q[1];
+            p += 2;
+        } else {
+            flags |= AI_PROTO_PACKED_IR_WIDE;
+            put_f32(p, snap->ir.x);
+            put_f32(p + 4, snap->ir.y);
+            p += 8;
+        }
+    }
+    if (snap->gyro.valid) {
+        flags |= AI_PROTO_PACKED_GYRO_VALID;
+        if (prev->gyro.valid &&
+            quantize_delta(snap->gyro.pitch, prev->gyro.pitch, AI_PROTO_GYRO_QUANT, &q[0]) &&
+            quantize_delta(snap->gyro.roll, prev->gyro.roll, AI_PROTO_GYRO_QUANT, &q[1]) &&
+            quantize_delta(snap->gyro.yaw, prev->gyro.yaw, AI_PROTO_GYRO_QUANT, &q[2])) {
+            p[0] = (u8)q[0]; p[1] = (u8)q[1]; p[2] = (u8)q[2];
+            p += 3;
+        } else {
+            flags |= AI_PROTO_PACKED_GYRO_WIDE;
+            put_f32(p, snap->gyro.pitch);
+            put_f32(p + 4, snap->gyro.roll);
+            put_f32(p + 8, snap->gyro.yaw);
+            p += 12;
+        }
+    }
+
+    start[0] = flags;
+    return (int)(p - start);
+}
+
+/*
+ * Encode a full AI request frame
+ */
+int ai_protocol_encode_request(const AIRequest* request, u32 sequence,
+                               u8* buf, int buf_len) {
+    int input_count = request->input_count;
+    if (input_count > AI_REQUEST_MAX_INPUTS) {
+        input_count = AI_REQUEST_MAX_INPUTS;
+    }
+
+    int payload_len = AI_PROTO_REQUEST_FIXED_SIZE +
+                      input_count * AI_PROTO_SNAPSHOT_SIZE;
+    int frame_len = AI_PROTO_HEADER_SIZE + payload_len;
+    if (buf_len < frame_len) {
+        return -1;
+    }
+
+    write_header(buf, AI_PKT_REQUEST, sequence, (u16)payload_len);
+
+    u8* p = buf + AI_PROTO_HEADER_SIZE;
+
+    // Identity and counts
+    p[0] = (u8)request->player_id;
+    p[1] = (u8)input_count;
+    p[2] = (u8)request->game_state.game_type;
+    p[3] = request->game_state.ai_enabled ? 1 : 0;
+    put_u64(p + 4, request->timestamp);
+
+    // Gesture analysis
+    p[12] = (u8)request->gesture.type;
+    p[13] = 0;
+    put_u16(p + 14, 0);
+    put_f32(p + 16, request->gesture.intensity);
+    put_f32(p + 20, request->gesture.confidence);
+
+    // Player profile
+    put_f32(p + 24, request->player_profile.skill_level);
+    put_f32(p + 28, request->player_profile.learning_rate);
+    put_f32(p + 32, request->player_profile.adaptation_speed);
+
+    // Game state
+    put_u32(p + 36, (u32)request->game_state.current_level);
+    put_u32(p + 40, request->game_state.frame_count);
+    put_f32(p + 44, request->game_state.difficulty);
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        put_u32(p + 48 + i * 4, (u32)request->game_state.player_scores[i]);
+    }
+    put_u32(p + 64, 0);  // reserved
+    put_u32(p + 68, 0);  // reserved
+
+    // Recent input snapshots
+    p += AI_PROTO_REQUEST_FIXED_SIZE;
+    for (int i = 0; i < input_count; i++) {
+        encode_snapshot(p, &request->recent_inputs[i], request->timestamp);
+        p += AI_PROTO_SNAPSHOT_SIZE;
+    }
+
+    return frame_len;
+}
+
+/*
+ * Decode one response payload block (AI_PROTO_RESPONSE_SIZE bytes)
+ */
+static void decode_response_payload(const u8* p, AIResponse* response) {
+    response->player_id = p[0];
+    response->input_enhancement.enabled = (p[1] & 0x01) != 0;
+    response->timestamp = get_u64(p + 4);
+    response->difficulty_adjustment = get_f32(p + 12);
+    response->learning_rate_adjustment = get_f32(p + 16);
+    response->input_enhancement.sensitivity_multiplier = get_f32(p + 20);
+    response->npc_behavior.aggression = get_f32(p + 24);
+    response->npc_behavior.intelligence = get_f32(p + 28);
+}
+
+/*
+ * Decode and validate an AI response frame
+ */
+int ai_protocol_decode_response(const u8* buf, int len,
+                                AIResponse* response, u32* sequence) {
+    if (len < AI_PROTO_HEADER_SIZE + AI_PROTO_RESPONSE_SIZE) {
+        return -1;
+    }
+    if (get_u16(buf) != AI_PROTO_MAGIC) {
+        return -1;
+    }
+    if (buf[2] != AI_PROTO_VERSION || buf[3] != AI_PKT_RESPONSE) {
+        return -1;
+    }
+    if (get_u16(buf + 8) != AI_PROTO_RESPONSE_SIZE) {
+        return -1;
+    }
+
+    if (sequence) {
+        *sequence = get_u32(buf + 4);
+    }
+
+    decode_response_payload(buf + AI_PROTO_HEADER_SIZE, response);
+    return 0;
+}
+
+/*
+ * Worst-case encoded size of every player slice in a batch; packed
+ * snapshots never exceed a full block, so this also bounds v2 frames
+ */
+static int batch_slices_max_size(const AIBatchRequest* batch,
+                                 int player_count) {
+    int size = 0;
+    for (int i = 0; i < player_count; i++) {
+        int input_count = batch->players[i].input_count;
+        if (input_count > AI_REQUEST_MAX_INPUTS) {
+            input_count = AI_REQUEST_MAX_INPUTS;
+        }
+        size += AI_PROTO_PLAYER_SLICE_FIXED_SIZE +
+                input_count * AI_PROTO_SNAPSHOT_SIZE;
+    }
+    return size;
+}
+
+/*
+ * Encode every player slice of a batch at p; returns the byte count.
+ * The first snapshot of each window is a full block; the rest are
+ * packed deltas assembled during this same walk.
+ */
+static int encode_player_slices(u8* p, const AIBatchRequest* batch,
+                                int player_count) {
+    u8* start = p;
+    for (int i = 0; i < player_count; i++) {
+        const AIPlayerSlice* slice = &batch->players[i];
+        int input_count = slice->input_count;
+        if (input_count > AI_REQUEST_MAX_INPUTS) {
+            input_count = AI_REQUEST_MAX_INPUTS;
+        }
+
+        p[0] = (u8)slice->player_id;
+        p[1] = (u8)input_count;
+        p[2] = (u8)slice->gesture.type;
+        p[3] = 0;
+        put_f32(p + 4, slice->gesture.intensity);
+        put_f32(p + 8, slice->gesture.confidence);
+        put_f32(p + 12, slice->profile.skill_level);
+        put_f32(p + 16, slice->profile.learning_rate);
+        put_f32(p + 20, slice->profile.adaptation_speed);
+        p += AI_PROTO_PLAYER_SLICE_FIXED_SIZE;
+
+        for (int j = 0; j < input_count; j++) {
+            if (j == 0) {
+                encode_snapshot(p, &slice->recent_inputs[0],
+                                batch->timestamp);
+                p += AI_PROTO_SNAPSHOT_SIZE;
+            } else {
+                p += encode_packed_snapshot(p, &slice->recent_inputs[j],
+                                            &slice->recent_inputs[j - 1],
+                                            batch->timestamp);
+            }
+        }
+    }
+    return (int)(p - start);
+}
+
+/*
+ * Encode a batched multi-player request frame (keyframe). The full
+ * game state is written once in the shared block; each connected
+ * player contributes a fixed slice plus its input snapshots.
+ */
+int ai_protocol_encode_batch_request(const AIBatchRequest* batch,
+                                     u32 sequence, u8* buf, int buf_len) {
+    int player_count = batch->player_count;
+    if (player_count > MAX_PLAYERS) {
+        player_count = MAX_PLAYERS;
+    }
+
+    // Bound the check by the worst case; the actual frame length is
+    // known only after the packed slices are assembled
+    int max_payload = AI_PROTO_BATCH_SHARED_SIZE +
+                      batch_slices_max_size(batch, player_count);
+    if (buf_len < AI_PROTO_HEADER_SIZE + max_payload) {
+        return -1;
+    }
+
+    // Shared block: timestamp and the single game state copy
+    u8* p = buf + AI_PROTO_HEADER_SIZE;
+    put_u64(p, batch->timestamp);
+    p[8] = (u8)batch->game_state.game_type;
+    p[9] = batch->game_state.ai_enabled ? 1 : 0;
+    p[10] = (u8)player_count;
+    p[11] = 0;
+    put_u32(p + 12, (u32)batch->game_state.current_level);
+    put_u32(p + 16, batch->game_state.frame_count);
+    put_f32(p + 20, batch->game_state.difficulty);
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        put_u32(p + 24 + i * 4, (u32)batch->game_state.player_scores[i]);
+    }
+    p += AI_PROTO_BATCH_SHARED_SIZE;
+
+    int payload_len = AI_PROTO_BATCH_SHARED_SIZE +
+                      encode_player_slices(p, batch, player_count);
+    write_header(buf, AI_PKT_BATCH_REQUEST, sequence, (u16)payload_len);
+    return AI_PROTO_HEADER_SIZE + payload_len;
+}
+
+/*
+ * Encode a delta batch: frame count always travels, every other
+ * GameState field only when its GS_DIRTY bit is set. Steady-state
+ * frames (mask 0) carry 16 bytes of shared state instead of 40.
+ */
+int ai_protocol_encode_batch_delta(const AIBatchRequest* batch,
+                                   u32 sequence, u8 dirty_mask,
+                                   u8* buf, int buf_len) {
+    int player_count = batch->player_count;
+    if (player_count > MAX_PLAYERS) {
+        player_count = MAX_PLAYERS;
+    }
+
+    // Dirty fields in bit order: sizes per GS_DIRTY layout
+    int delta_len = 0;
+    if (dirty_mask & GS_DIRTY_GAME_TYPE) delta_len += 1;
+    if (dirty_mask & GS_DIRTY_AI_ENABLED) delta_len += 1;
+    if (dirty_mask & GS_DIRTY_LEVEL) delta_len += 4;
+    if (dirty_mask & GS_DIRTY_DIFFICULTY) delta_len += 4;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (dirty_mask & GS_DIRTY_SCORE(i)) delta_len += 4;
+    }
+
+    int max_payload = AI_PROTO_DELTA_FIXED_SIZE + delta_len +
+                      batch_slices_max_size(batch, player_count);
+    if (buf_len < AI_PROTO_HEADER_SIZE + max_payload) {
+        return -1;
+    }
+
+    u8* p = buf + AI_PROTO_HEADER_SIZE;
+    put_u64(p, batch->timestamp);
+    put_u32(p + 8, batch->game_state.frame_count);
+    p[12] = dirty_mask;
+    p[13] = (u8)player_count;
+    put_u16(p + 14, 0);
+    p += AI_PROTO_DELTA_FIXED_SIZE;
+
+    if (dirty_mask & GS_DIRTY_GAME_TYPE) {
+        *p++ = (u8)batch->game_state.game_type;
+    }
+    if (dirty_mask & GS_DIRTY_AI_ENABLED) {
+        *p++ = batch->game_state.ai_enabled ? 1 : 0;
+    }
+    if (dirty_mask & GS_DIRTY_LEVEL) {
+        put_u32(p, (u32)batch->game_state.current_level);
+        p += 4;
+    }
+    if (dirty_mask & GS_DIRTY_DIFFICULTY) {
+        put_f32(p, batch->game_state.difficulty);
+        p += 4;
+    }
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (dirty_mask & GS_DIRTY_SCORE(i)) {
+            put_u32(p, (u32)batch->game_state.player_scores[i]);
+            p += 4;
+        }
+    }
+
+    int payload_len = (int)(p - (buf + AI_PROTO_HEADER_SIZE)) +
+                      encode_player_slices(p, batch, player_count);
+    write_header(buf, AI_PKT_BATCH_DELTA, sequence, (u16)payload_len);
+    return AI_PROTO_HEADER_SIZE + payload_len;
+}
+
+/*
+ * Decode and validate a batched response frame
+ */
+int ai_protocol_decode_batch_response(const u8* buf, int len,
+                                      AIBatchResponse* batch,
+                                      u32* sequence) {
+    int count = 0;
+    if (ai_protocol_validate_batch_response(buf, len, &count, sequence) != 0) {
+        return -1;
+    }
+
+    batch->response_count = count;
+    for (int i = 0; i < count; i++) {
+        decode_response_payload(ai_protocol_batch_response_slice(buf, i),
+                                &batch->responses[i]);
+    }
+    return 0;
+}
+
+/*
+ * Validate a batched response frame in place; no payload bytes move
+ */
+int ai_protocol_validate_batch_response(const u8* buf, int len,
+                                        int* response_count,
+                                        u32* sequence) {
+    if (len < AI_PROTO_HEADER_SIZE + 4) {
+        return -1;
+    }
+    if (get_u16(buf) != AI_PROTO_MAGIC) {
+        return -1;
+    }
+    if (buf[2] != AI_PROTO_VERSION || buf[3] != AI_PKT_BATCH_RESPONSE) {
+        return -1;
+    }
+
+    int count = buf[AI_PROTO_HEADER_SIZE];
+    if (count > MAX_PLAYERS) {
+        return -1;
+    }
+    int expected_payload = 4 + count * AI_PROTO_RESPONSE_SIZE;
+    if (get_u16(buf + 8) != expected_payload ||
+        len < AI_PROTO_HEADER_SIZE + expected_payload) {
+        return -1;
+    }
+
+    if (sequence) {
+        *sequence = get_u32(buf + 4);
+    }
+    *response_count = count;
+    return 0;
+}
+
+const u8* ai_protocol_batch_response_slice(const u8* buf, int index) {
+    return buf + AI_PROTO_HEADER_SIZE + 4 + index * AI_PROTO_RESPONSE_SIZE;
+}
+
+int ai_protocol_response_slice_player(const u8* slice) {
+    return slice[0];
+}
+
+void ai_protocol_decode_response_payload(const u8* slice, AIResponse* out) {
+    decode_response_payload(slice, out);
+}
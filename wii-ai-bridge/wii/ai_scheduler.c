@@ -0,0 +1,119 @@
+/*
+ * Deferred AI job scheduler implementation
+ *
+ * A small insertion-sorted array stands in for a heap: the queue
+ * tops out at a handful of entries, so keeping it ordered on push
+ * costs less than heap bookkeeping and makes drain a straight scan.
+ */
+
+#include <string.h>
+#include <gccore.h>
+
+#include "ai_scheduler.h"
+#include "game_state.h"
+
+typedef struct {
+    AIJobType type;
+    u8 priority;
+    u32 step;           // resume cursor for spanning jobs
+    WiiPlayer* player;  // AI_JOB_NPC_BEHAVIOR only
+} AIJob;
+
+static AIJob job_queue[AI_JOB_QUEUE_SIZE];
+static u32 job_count = 0;
+
+// Content double buffer: the step hook writes staging across frames,
+// publish copies it into the other slot and flips which slot readers
+// see. Everything runs on the main thread, so "atomic" here means a
+// reader between drains never observes a half-built buffer.
+static DynamicContent content_slots[2];
+static u32 content_published_slot = 0;
+static u32 content_sequence = 0;
+
+void ai_scheduler_reset(void) {
+    job_count = 0;
+}
+
+int ai_scheduler_push(AIJobType type, u8 priority, WiiPlayer* player) {
+    // Dedupe: re-requesting work that is already queued is a no-op
+    for (u32 i = 0; i < job_count; i++) {
+        if (job_queue[i].type == type && job_queue[i].player == player) {
+            return 0;
+        }
+    }
+    if (job_count >= AI_JOB_QUEUE_SIZE) {
+        return -1;
+    }
+
+    // Insert keeping the queue ordered by priority (stable)
+    u32 pos = job_count;
+    while (pos > 0 && job_queue[pos - 1].priority > priority) {
+        job_queue[pos] = job_queue[pos - 1];
+        pos--;
+    }
+    job_queue[pos].type = type;
+    job_queue[pos].priority = priority;
+    job_queue[pos].step = 0;
+    job_queue[pos].player = player;
+    job_count++;
+    return 0;
+}
+
+// Run one step of a job; returns true when the job is complete
+static bool run_job_step(AIJob* job) {
+    switch (job->type) {
+        case AI_JOB_GLOBAL_DIFFICULTY:
+            adjust_global_difficulty();
+            return true;
+        case AI_JOB_NPC_BEHAVIOR:
+            if (job->player && job->player->connected) {
+                update_npc_behavior_for_player(job->player);
+            }
+            return true;
+        case AI_JOB_DYNAMIC_CONTENT:
+            return generate_dynamic_content_step(job->step++);
+    }
+    return true;
+}
+
+void ai_scheduler_drain(void) {
+    if (job_count == 0) return;
+
+    u64 start = gettime();
+
+    // At least one step runs per drain so the queue can never starve
+    // under a mis-set budget. The head is the highest-priority job;
+    // it keeps stepping until it finishes or the budget runs out, so
+    // a spanning content job never blocks more than one drain's slack
+    // in any single frame.
+    do {
+        if (run_job_step(&job_queue[0])) {
+            job_count--;
+            memmove(job_queue, job_queue + 1, job_count * sizeof(AIJob));
+        }
+    } while (job_count > 0 &&
+             diff_usec(start, gettime()) < AI_FRAME_BUDGET_US);
+}
+
+u32 ai_scheduler_pending(void) {
+    return job_count;
+}
+
+u8* ai_scheduler_content_staging(void) {
+    return content_slots[content_published_slot ^ 1].data;
+}
+
+void ai_scheduler_content_publish(u32 size) {
+    if (size > DYNAMIC_CONTENT_MAX_SIZE) {
+        size = DYNAMIC_CONTENT_MAX_SIZE;
+    }
+    u32 slot = content_published_slot ^ 1;
+    content_slots[slot].sequence = ++content_sequence;
+    content_slots[slot].size = size;
+    content_published_slot = slot;
+}
+
+const DynamicContent* ai_scheduler_content_latest(void) {
+    if (content_sequence == 0) return NULL;
+    return &content_slots[content_published_slot];
+}
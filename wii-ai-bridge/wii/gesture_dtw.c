@@ -0,0 +1,206 @@
+/*
+ * DTW gesture template matcher implementation
+ *
+ * Distances run in the quantized u8 domain: the query window is
+ * quantized once per match, costs are integer |a - b|, and the band
+ * rows fit in two small stack arrays. The acceptance cut and the
+ * early-abandon bound work on the same per-step-normalized scale so
+ * pruning never changes the result.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gccore.h>
+
+#include "gesture_dtw.h"
+
+// Worst acceptable mean per-step cost (quantized units). Matches
+// above this are reported as "no gesture" and the caller keeps the
+// threshold classification.
+#define DTW_ACCEPT_COST 28.0f
+
+typedef struct {
+    u8 type;    // GestureType
+    u8 length;
+    u8 samples[DTW_MAX_TEMPLATE_LEN];
+} GestureTemplate;
+
+// Compiled-in default library: shapes are quantized accel-delta
+// magnitude profiles, oldest sample first.
+//   - full swing: smooth rise to a high peak and release
+//   - short swing: the same arc compressed, for quick strokes
+//   - flick: one sharp spike from rest (reads as SHAKE)
+//   - thrust: fast attack into a sustained plateau
+static const GestureTemplate builtin_templates[] = {
+    { GESTURE_SWING, 12, { 10, 30, 70, 120, 180, 220, 230, 200, 140, 80, 40, 15 } },
+    { GESTURE_SWING,  8, { 20, 80, 160, 225, 225, 150, 70, 25 } },
+    { GESTURE_SHAKE,  6, { 8, 15, 200, 210, 30, 10 } },
+    { GESTURE_THRUST, 10, { 15, 90, 190, 210, 205, 200, 195, 190, 120, 40 } },
+};
+
+static GestureTemplate templates[DTW_MAX_TEMPLATES];
+static int template_count = 0;
+
+static void install_builtin_library(void) {
+    template_count = (int)(sizeof(builtin_templates) /
+                           sizeof(builtin_templates[0]));
+    memcpy(templates, builtin_templates, sizeof(builtin_templates));
+}
+
+static u8 quantize_magnitude(float mag) {
+    float scaled = (mag / DTW_QUANT_RANGE) * 255.0f;
+    if (scaled < 0.0f) return 0;
+    if (scaled > 255.0f) return 255;
+    return (u8)scaled;
+}
+
+/*
+ * Load the preprocessed template blob. Any validation failure leaves
+ * the compiled-in library installed.
+ */
+int gesture_dtw_load(const char* path) {
+    install_builtin_library();
+
+    FILE* f = fopen(path ? path : DTW_BLOB_PATH, "rb");
+    if (!f) {
+        return -1;
+    }
+
+    u8 header[4];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) ||
+        (u16)(header[0] | (header[1] << 8)) != DTW_BLOB_MAGIC ||
+        header[2] != DTW_BLOB_VERSION) {
+        fclose(f);
+        printf("Gesture templates: bad blob header, using builtins\n");
+        return -1;
+    }
+
+    int count = header[3];
+    if (count < 1 || count > DTW_MAX_TEMPLATES) {
+        fclose(f);
+        printf("Gesture templates: bad count %d, using builtins\n", count);
+        return -1;
+    }
+
+    GestureTemplate loaded[DTW_MAX_TEMPLATES];
+    for (int i = 0; i < count; i++) {
+        u8 desc[4];
+        if (fread(desc, 1, sizeof(desc), f) != sizeof(desc) ||
+            desc[1] < 2 || desc[1] > DTW_MAX_TEMPLATE_LEN) {
+            fclose(f);
+            printf("Gesture templates: truncated blob, using builtins\n");
+            return -1;
+        }
+        loaded[i].type = desc[0];
+        loaded[i].length = desc[1];
+        if (fread(loaded[i].samples, 1, desc[1], f) != desc[1]) {
+            fclose(f);
+            printf("Gesture templates: truncated blob, using builtins\n");
+            return -1;
+        }
+    }
+    fclose(f);
+
+    memcpy(templates, loaded, count * sizeof(GestureTemplate));
+    template_count = count;
+    printf("Gesture templates: %d loaded from %s\n",
+           count, path ? path : DTW_BLOB_PATH);
+    return 0;
+}
+
+int gesture_dtw_count(void) {
+    if (template_count == 0) {
+        install_builtin_library();
+    }
+    return template_count;
+}
+
+/*
+ * Banded DTW distance between a quantized query and one template,
+ * normalized per warp step. Abandons as soon as the minimum of the
+ * current band row can no longer beat best_cost.
+ */
+static float banded_dtw(const u8* query, int qlen,
+                        const GestureTemplate* tmpl, float best_cost) {
+    // Two rolling rows over the template axis, band cells only
+    float rows[2][DTW_MAX_TEMPLATE_LEN + 1];
+    int tlen = tmpl->length;
+    int steps = (qlen > tlen) ? qlen : tlen;
+    float abandon = best_cost * (float)steps;
+
+    float* prev = rows[0];
+    float* curr = rows[1];
+    for (int j = 0; j <= tlen; j++) {
+        prev[j] = 1e9f;
+    }
+    prev[0] = 0.0f;
+
+    for (int i = 1; i <= qlen; i++) {
+        // Band limits along the template, following the diagonal
+        int center = (i * tlen) / qlen;
+        int lo = center - DTW_BAND;
+        int hi = center + DTW_BAND;
+        if (lo < 1) lo = 1;
+        if (hi > tlen) hi = tlen;
+
+        for (int j = 0; j <= tlen; j++) {
+            curr[j] = 1e9f;
+        }
+
+        float row_min = 1e9f;
+        for (int j = lo; j <= hi; j++) {
+            int d = (int)query[i - 1] - (int)tmpl->samples[j - 1];
+            if (d < 0) d = -d;
+
+            float best_prev = prev[j];  // insertion
+            if (prev[j - 1] < best_prev) best_prev = prev[j - 1];  // match
+            if (curr[j - 1] < best_prev) best_prev = curr[j - 1];  // deletion
+
+            curr[j] = (float)d + best_prev;
+            if (curr[j] < row_min) row_min = curr[j];
+        }
+
+        // Early abandon: every remaining path goes through this row
+        if (row_min >= abandon) {
+            return 1e9f;
+        }
+
+        float* swap = prev;
+        prev = curr;
+        curr = swap;
+    }
+
+    return prev[tlen] / (float)steps;
+}
+
+int gesture_dtw_match(const float* window, int count, float* confidence) {
+    if (confidence) *confidence = 0.0f;
+    if (!window || count < 2) return -1;
+    if (template_count == 0) install_builtin_library();
+
+    if (count > DTW_MAX_TEMPLATE_LEN) {
+        // Match against the newest template-length span
+        window += count - DTW_MAX_TEMPLATE_LEN;
+        count = DTW_MAX_TEMPLATE_LEN;
+    }
+
+    u8 query[DTW_MAX_TEMPLATE_LEN];
+    for (int i = 0; i < count; i++) {
+        query[i] = quantize_magnitude(window[i]);
+    }
+
+    float best = DTW_ACCEPT_COST;
+    int best_type = -1;
+    for (int t = 0; t < template_count; t++) {
+        float cost = banded_dtw(query, count, &templates[t], best);
+        if (cost < best) {
+            best = cost;
+            best_type = templates[t].type;
+        }
+    }
+
+    if (best_type >= 0 && confidence) {
+        *confidence = 1.0f - best / DTW_ACCEPT_COST;
+    }
+    return best_type;
+}
@@ -0,0 +1,90 @@
+/*
+ * Gesture feature extraction kernels
+ *
+ * The Gekko path keeps the x/y components in one paired-single lane
+ * pair (ps_sub/ps_mul/ps_sum0) and finishes the magnitude with
+ * frsqrte plus two Newton-Raphson steps instead of calling libm
+ * sqrtf. GestureSample lays its accel floats out contiguously
+ * (x, y, z), which the psq_l offset below relies on.
+ */
+
+#include <math.h>
+
+#include "gesture_simd.h"
+
+#ifdef GEKKO
+
+/*
+ * sqrt(s) = s * rsqrt(s), refined to full f32 precision
+ */
+static inline float fast_sqrt(float s) {
+    if (s <= 0.0f) return 0.0f;
+    float r;
+    asm("frsqrte %0, %1" : "=f"(r) : "f"(s));
+    r = r * (1.5f - 0.5f * s * r * r);
+    r = r * (1.5f - 0.5f * s * r * r);
+    return s * r;
+}
+
+/*
+ * Squared accel delta for one sample pair: x/y in one paired lane,
+ * z folded in with a scalar fmadds
+ */
+static float accel_delta_sq(const GestureSample* prev,
+                            const GestureSample* curr) {
+    float sum;
+    asm volatile (
+        "psq_l      2, 0(%1), 0, 0\n"   // prev accel x,y
+        "psq_l      3, 0(%2), 0, 0\n"   // curr accel x,y
+        "ps_sub     3, 3, 2\n"          // dx, dy
+        "lfs        4, 8(%1)\n"
+        "lfs        5, 8(%2)\n"
+        "fsubs      5, 5, 4\n"          // dz
+        "ps_mul     3, 3, 3\n"          // dx^2, dy^2
+        "ps_sum0    3, 3, 3, 3\n"       // dx^2 + dy^2
+        "fmadds     %0, 5, 5, 3\n"      // + dz^2
+        : "=f"(sum)
+        : "b"(prev), "b"(curr)
+        // "memory" orders the loads after any pending stores to the
+        // sample arrays; without it the compiler may sink them past
+        // the asm since only the pointers are declared as inputs
+        : "fr2", "fr3", "fr4", "fr5", "memory");
+    return sum;
+}
+
+float gesture_delta_magnitude(const GestureSample* prev,
+                              const GestureSample* curr) {
+    return fast_sqrt(accel_delta_sq(prev, curr));
+}
+
+#else  // !GEKKO: scalar fallback for host builds
+
+float gesture_delta_magnitude(const GestureSample* prev,
+                              const GestureSample* curr) {
+    float dx = curr->accel_x - prev->accel_x;
+    float dy = curr->accel_y - prev->accel_y;
+    float dz = curr->accel_z - prev->accel_z;
+    return sqrtf(dx*dx + dy*dy + dz*dz);
+}
+
+#endif // GEKKO
+
+/*
+ * Batch extraction over the whole window, oldest pair first
+ */
+int gesture_extract_magnitudes(const GestureBuffer* buffer,
+                               float* out, int max_out) {
+    int pairs = buffer->sample_count - 1;
+    if (pairs > max_out) pairs = max_out;
+
+    int written = 0;
+    for (int i = pairs; i >= 1; i--) {
+        int prev_idx = (buffer->write_index - i - 1 + GESTURE_BUFFER_SIZE)
+                       % GESTURE_BUFFER_SIZE;
+        int curr_idx = (buffer->write_index - i + GESTURE_BUFFER_SIZE)
+                       % GESTURE_BUFFER_SIZE;
+        out[written++] = gesture_delta_magnitude(&buffer->samples[prev_idx],
+                                                 &buffer->samples[curr_idx]);
+    }
+    return written;
+}
@@ -0,0 +1,76 @@
+/*
+ * AI Bridge request/response definitions
+ *
+ * In-memory message structures exchanged between the Wii bridge and
+ * the AI engine. Wire encoding lives in ai_protocol.h.
+ */
+
+#ifndef AI_BRIDGE_H
+#define AI_BRIDGE_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+#include "game_state.h"
+
+// Maximum recent inputs attached to one request
+#define AI_REQUEST_MAX_INPUTS 5
+
+// Request sent to the AI engine for one player
+typedef struct {
+    int player_id;
+    u64 timestamp;
+    GestureAnalysis gesture;
+    int input_count;
+    InputSnapshot recent_inputs[AI_REQUEST_MAX_INPUTS];
+    GameState game_state;
+    AIProfile player_profile;
+} AIRequest;
+
+// Input enhancement parameters returned by the AI engine
+typedef struct {
+    bool enabled;
+    float sensitivity_multiplier;
+} InputEnhancement;
+
+// NPC tuning parameters returned by the AI engine
+typedef struct {
+    float aggression;
+    float intelligence;
+} NPCBehavior;
+
+// Response received from the AI engine for one player
+typedef struct {
+    int player_id;
+    u64 timestamp;
+    float difficulty_adjustment;
+    float learning_rate_adjustment;
+    InputEnhancement input_enhancement;
+    NPCBehavior npc_behavior;
+} AIResponse;
+
+// Per-player portion of a batched request
+typedef struct {
+    int player_id;
+    GestureAnalysis gesture;
+    AIProfile profile;
+    int input_count;
+    InputSnapshot recent_inputs[AI_REQUEST_MAX_INPUTS];
+} AIPlayerSlice;
+
+// Batched request covering every connected player in one datagram,
+// with a single shared copy of the game state
+typedef struct {
+    u64 timestamp;
+    GameState game_state;
+    int player_count;
+    AIPlayerSlice players[MAX_PLAYERS];
+} AIBatchRequest;
+
+// Batched response, fanned out per player on receipt
+typedef struct {
+    int response_count;
+    AIResponse responses[MAX_PLAYERS];
+} AIBatchResponse;
+
+#endif // AI_BRIDGE_H
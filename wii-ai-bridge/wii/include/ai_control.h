@@ -0,0 +1,80 @@
+/*
+ * Difficulty and enhancement controller policy
+ *
+ * The local-AI fallback runs this policy every cycle, and with the
+ * adaptive deadline it can end up running every frame as the
+ * predictive layer. The float reference implementation and a Q16.16
+ * fixed-point variant live side by side: the fixed path uses only
+ * integer multiplies and shifts, with the normalization constants
+ * (the 1/2 performance blend, the 1/10 adjustment gain, and so on)
+ * precomputed as Q16.16 reciprocals, so on Gekko it stays off the
+ * FPU entirely. Both take the same inputs and must agree to Q16.16
+ * precision; the host benchmark build verifies them against each
+ * other across the input range.
+ */
+
+#ifndef AI_CONTROL_H
+#define AI_CONTROL_H
+
+#include <gccore.h>
+
+// Q16.16 fixed point: 16 integer bits, 16 fraction bits. Every value
+// the policy touches lives in [-2, 2], so headroom is never a concern
+// here.
+typedef s32 q16_t;
+
+#define Q16_ONE 0x10000
+#define Q16(x) ((q16_t)((x) * 65536.0f + ((x) >= 0 ? 0.5f : -0.5f)))
+
+static inline q16_t q16_from_float(float f) {
+    return (q16_t)(f * 65536.0f);
+}
+
+static inline float q16_to_float(q16_t v) {
+    return (float)v * (1.0f / 65536.0f);
+}
+
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    return (q16_t)(((s64)a * (s64)b) >> 16);
+}
+
+static inline q16_t q16_clamp(q16_t v, q16_t lo, q16_t hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+// Policy outputs, as written into the AIResponse fields
+typedef struct {
+    float difficulty_adjustment;
+    float sensitivity_multiplier;
+    float npc_aggression;
+    float npc_intelligence;
+} AIControlPolicy;
+
+// Float reference implementation
+void ai_control_policy_float(float gesture_confidence, float consistency,
+                             float skill_level, float difficulty,
+                             AIControlPolicy* out);
+
+// Q16.16 implementation, integer ops only between the conversions
+void ai_control_policy_fixed(float gesture_confidence, float consistency,
+                             float skill_level, float difficulty,
+                             AIControlPolicy* out);
+
+// Difficulty clamp to [0.1, 1.0] after applying an adjustment
+float ai_control_clamp_difficulty_float(float difficulty);
+float ai_control_clamp_difficulty_fixed(float difficulty);
+
+// Build selection: Gekko builds take the fixed path (integer units,
+// FPU left free for the gesture kernels); define AI_CTRL_FLOAT to
+// force the reference implementation on any target.
+#if defined(GEKKO) && !defined(AI_CTRL_FLOAT)
+#define ai_control_policy ai_control_policy_fixed
+#define ai_control_clamp_difficulty ai_control_clamp_difficulty_fixed
+#else
+#define ai_control_policy ai_control_policy_float
+#define ai_control_clamp_difficulty ai_control_clamp_difficulty_float
+#endif
+
+#endif // AI_CONTROL_H
@@ -0,0 +1,147 @@
+/*
+ * Binary wire protocol for AI Bridge network traffic
+ *
+ * Packed, versioned, little-endian frames replacing the old JSON text
+ * round trip. Every frame starts with a fixed header carrying a magic
+ * value, protocol version, packet type, sequence number and payload
+ * length, so either end can validate and resequence datagrams cheaply.
+ * The Gekko is big-endian; encode/decode go through explicit
+ * little-endian store/load helpers so the layout matches the decoder
+ * in core/wii_protocol.py byte for byte.
+ */
+
+#ifndef AI_PROTOCOL_H
+#define AI_PROTOCOL_H
+
+#include <gccore.h>
+
+#include "ai_bridge.h"
+
+// Frame identification
+#define AI_PROTO_MAGIC   0x4257  // "WB"
+#define AI_PROTO_VERSION 2
+
+// UDP port the AI engine listens on (mirrored as AI_ENGINE_PORT in
+// core/wii_protocol.py; the batch server binds it by default)
+#define AI_ENGINE_PORT 8080
+
+// Packet types
+#define AI_PKT_REQUEST        1
+#define AI_PKT_RESPONSE       2
+#define AI_PKT_BATCH_REQUEST  3
+#define AI_PKT_BATCH_RESPONSE 4
+#define AI_PKT_BATCH_DELTA    5
+
+// Fixed header layout (12 bytes):
+//   u16 magic, u8 version, u8 type, u32 sequence, u16 payload_len, u16 reserved
+#define AI_PROTO_HEADER_SIZE 12
+
+// Encoded payload sizes
+#define AI_PROTO_SNAPSHOT_SIZE 48
+#define AI_PROTO_REQUEST_FIXED_SIZE 72
+#define AI_PROTO_RESPONSE_SIZE 32
+
+// Batch layout sizes
+#define AI_PROTO_BATCH_SHARED_SIZE 40
+#define AI_PROTO_PLAYER_SLICE_FIXED_SIZE 24
+
+// Packed delta snapshots (protocol v2): inside a batch slice only the
+// first snapshot is a full AI_PROTO_SNAPSHOT_SIZE block; consecutive
+// 60 Hz samples differ slightly, so the rest carry a presence mask
+// and quantized s8 per-field deltas against the previous snapshot,
+// escaping to absolute f32 when a delta overflows its scale. IR and
+// gyro are absent entirely while invalid. Typical packed snapshots
+// run ~8-13 bytes, keeping full 4-player batches near 512 bytes on
+// the wire.
+#define AI_PROTO_PACKED_BTN_HELD   0x01  // u32 buttons_held follows
+#define AI_PROTO_PACKED_BTN_EDGE   0x02  // u32 buttons_pressed follows
+#define AI_PROTO_PACKED_ACCEL_WIDE 0x04  // accel absolute (3 f32)
+#define AI_PROTO_PACKED_IR_VALID   0x08
+#define AI_PROTO_PACKED_IR_WIDE    0x10  // ir absolute (2 f32)
+#define AI_PROTO_PACKED_GYRO_VALID 0x20
+#define AI_PROTO_PACKED_GYRO_WIDE  0x40  // gyro absolute (3 f32)
+
+// Quantization scales (value units per s8 LSB)
+#define AI_PROTO_ACCEL_QUANT (1.0f / 64.0f)
+#define AI_PROTO_IR_QUANT    0.5f
+#define AI_PROTO_GYRO_QUANT  (1.0f / 16.0f)
+
+// Worst-case packed snapshot: flags + ts + wide accel/ir/gyro + both
+// button words
+#define AI_PROTO_PACKED_SNAPSHOT_MAX_SIZE (1 + 4 + 12 + 8 + 12 + 8)
+
+// Delta batch fixed block (16 bytes): timestamp u64, frame u32,
+// dirty mask u8, player_count u8, pad u16. Dirty GameState fields
+// follow in GS_DIRTY bit order (see game_state.h), then the player
+// slices unchanged. A keyframe (full AI_PKT_BATCH_REQUEST) goes out
+// periodically so the server can always resynchronize.
+#define AI_PROTO_DELTA_FIXED_SIZE 16
+
+// Every dirty GameState field present at once, in GS_DIRTY bit order:
+// game_type, ai_enabled, level, difficulty, one score per player
+#define AI_PROTO_DELTA_MAX_FIELDS (1 + 1 + 4 + 4 + MAX_PLAYERS * 4)
+
+// Worst-case frame sizes (all fit one UDP datagram). A fully dirty
+// delta's shared portion (16 + 26 bytes) outweighs a keyframe's
+// shared block (40), so the batch bound is sized off the delta.
+#define AI_PROTO_MAX_REQUEST_SIZE \
+    (AI_PROTO_HEADER_SIZE + AI_PROTO_REQUEST_FIXED_SIZE + \
+     AI_REQUEST_MAX_INPUTS * AI_PROTO_SNAPSHOT_SIZE)
+#define AI_PROTO_MAX_RESPONSE_SIZE \
+    (AI_PROTO_HEADER_SIZE + AI_PROTO_RESPONSE_SIZE)
+#define AI_PROTO_MAX_BATCH_REQUEST_SIZE \
+    (AI_PROTO_HEADER_SIZE + AI_PROTO_DELTA_FIXED_SIZE + \
+     AI_PROTO_DELTA_MAX_FIELDS + \
+     MAX_PLAYERS * (AI_PROTO_PLAYER_SLICE_FIXED_SIZE + \
+                    AI_REQUEST_MAX_INPUTS * AI_PROTO_SNAPSHOT_SIZE))
+#define AI_PROTO_MAX_BATCH_RESPONSE_SIZE \
+    (AI_PROTO_HEADER_SIZE + 4 + MAX_PLAYERS * AI_PROTO_RESPONSE_SIZE)
+
+// Encode a request into buf; returns encoded length or -1 if buf_len
+// is too small.
+int ai_protocol_encode_request(const AIRequest* request, u32 sequence,
+                               u8* buf, int buf_len);
+
+// Decode a response frame; validates magic, version, type and payload
+// length. Returns 0 on success, -1 on a malformed frame. The frame
+// sequence number is written to *sequence when non-NULL.
+int ai_protocol_decode_response(const u8* buf, int len,
+                                AIResponse* response, u32* sequence);
+
+// Encode a batched multi-player request; returns encoded length or -1.
+int ai_protocol_encode_batch_request(const AIBatchRequest* batch,
+                                     u32 sequence, u8* buf, int buf_len);
+
+// Encode a delta batch carrying only the GameState fields flagged in
+// dirty_mask; returns encoded length or -1.
+int ai_protocol_encode_batch_delta(const AIBatchRequest* batch,
+                                   u32 sequence, u8 dirty_mask,
+                                   u8* buf, int buf_len);
+
+// Decode a batched response; returns 0 on success, -1 on a malformed
+// frame.
+int ai_protocol_decode_batch_response(const u8* buf, int len,
+                                      AIBatchResponse* batch,
+                                      u32* sequence);
+
+// Zero-copy variant: validate a batched response frame where it
+// landed, without copying the payload out. On success fills the
+// response count and sequence and returns 0; the caller then walks
+// the slices with the accessors below and decodes each one straight
+// into its destination slot.
+int ai_protocol_validate_batch_response(const u8* buf, int len,
+                                        int* response_count,
+                                        u32* sequence);
+
+// Pointer to the index-th response slice of a validated batch frame
+const u8* ai_protocol_batch_response_slice(const u8* buf, int index);
+
+// Player id of a response slice, readable before the full decode so
+// the caller can route the decode by destination
+int ai_protocol_response_slice_player(const u8* slice);
+
+// Decode one validated response slice into out
+void ai_protocol_decode_response_payload(const u8* slice,
+                                         AIResponse* out);
+
+#endif // AI_PROTOCOL_H
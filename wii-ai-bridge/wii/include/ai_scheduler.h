@@ -0,0 +1,78 @@
+/*
+ * Budget-aware deferred AI job scheduler
+ *
+ * Game-side AI work (NPC behavior, global difficulty, dynamic
+ * content) used to run inline on the AI-interval frame, stacking on
+ * top of the batch assembly in that same frame. It is now queued as
+ * prioritized jobs and drained a little every frame, under a
+ * microsecond budget measured with the time base, so worst-case frame
+ * time stays flat as AI features grow.
+ *
+ * Jobs are resumable: a drain runs job steps, not whole jobs, so
+ * content generation that needs tens of milliseconds spans as many
+ * frames as it takes while each frame pays at most the budget. A
+ * spanning job keeps its step cursor in the queue between drains and
+ * publishes its result atomically through the content double buffer
+ * when its final step completes.
+ */
+
+#ifndef AI_SCHEDULER_H
+#define AI_SCHEDULER_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Deferred game-AI job kinds
+typedef enum {
+    AI_JOB_GLOBAL_DIFFICULTY = 0,
+    AI_JOB_NPC_BEHAVIOR,        // per player
+    AI_JOB_DYNAMIC_CONTENT
+} AIJobType;
+
+// Queue capacity: one difficulty + one content + one NPC job per
+// player is the steady-state worst case, with headroom
+#define AI_JOB_QUEUE_SIZE 16
+
+// Deferred-work budget per frame. Half a millisecond leaves the rest
+// of the 16.7 ms frame untouched even when the queue is full.
+#define AI_FRAME_BUDGET_US 500
+
+// Drop everything queued (bridge init/cleanup)
+void ai_scheduler_reset(void);
+
+// Queue a job; lower priority value runs first. A job identical to
+// one already queued (including one mid-resume) is deduplicated.
+// Returns 0, or -1 when full.
+int ai_scheduler_push(AIJobType type, u8 priority, WiiPlayer* player);
+
+// Run job steps until the frame budget is spent (always makes
+// progress on at least one step when any jobs are pending). A job
+// whose step function yields stays queued with its cursor advanced.
+void ai_scheduler_drain(void);
+
+// Jobs currently queued
+u32 ai_scheduler_pending(void);
+
+// Atomic publication buffer for multi-frame content generation.
+// The step hook builds into the staging buffer across as many drains
+// as it needs, then publishes in one call; readers always see either
+// the previous complete result or the new one, never a partial build.
+#define DYNAMIC_CONTENT_MAX_SIZE 512
+
+typedef struct {
+    u32 sequence;  // bumps on every publish; 0 = nothing published yet
+    u32 size;
+    u8 data[DYNAMIC_CONTENT_MAX_SIZE];
+} DynamicContent;
+
+// Staging buffer for the in-progress generation (step hook only)
+u8* ai_scheduler_content_staging(void);
+
+// Publish the staging buffer's first size bytes as the latest content
+void ai_scheduler_content_publish(u32 size);
+
+// Latest complete content, or NULL before the first publish
+const DynamicContent* ai_scheduler_content_latest(void);
+
+#endif // AI_SCHEDULER_H
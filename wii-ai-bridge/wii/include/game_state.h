@@ -0,0 +1,65 @@
+/*
+ * Game state definitions for AI Gaming Bridge
+ *
+ * Shared view of the running game that the bridge forwards to the AI
+ * engine and that game code reads back for difficulty and NPC tuning.
+ */
+
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Game categories the AI engine can specialize for
+typedef enum {
+    GAME_TYPE_MENU = 0,
+    GAME_TYPE_SPORTS,
+    GAME_TYPE_ADVENTURE,
+    GAME_TYPE_PARTY,
+    GAME_TYPE_FITNESS,
+    GAME_TYPE_RACING,
+    GAME_TYPE_FIGHTING
+} GameType;
+
+// Global game state shared with the AI engine
+typedef struct {
+    GameType game_type;
+    int current_level;
+    float difficulty;
+    bool ai_enabled;
+    u32 frame_count;
+    s32 player_scores[MAX_PLAYERS];
+} GameState;
+
+// Dirty bits tracking which GameState fields changed since the last
+// AI batch went out. The wire layer sends only dirty fields between
+// keyframes; frame_count always travels and has no bit.
+#define GS_DIRTY_GAME_TYPE  (1 << 0)
+#define GS_DIRTY_AI_ENABLED (1 << 1)
+#define GS_DIRTY_LEVEL      (1 << 2)
+#define GS_DIRTY_DIFFICULTY (1 << 3)
+#define GS_DIRTY_SCORE(i)   (1 << (4 + (i)))
+#define GS_DIRTY_ALL        0xFF
+
+// Bridge accessors
+GameState* wii_ai_get_game_state(void);
+void wii_ai_set_game_type(GameType type);
+void wii_ai_set_player_score(int player_id, s32 score);
+
+// Game code that mutates the state through wii_ai_get_game_state()
+// directly must flag what it touched so delta encoding stays correct
+void wii_ai_mark_game_state_dirty(u8 bits);
+
+// Game-side AI hooks driven through the job scheduler. Content
+// generation is resumable: the scheduler calls the step function
+// repeatedly under its frame budget with an incrementing step index,
+// and the hook returns true once the work item is complete. Partial
+// results must stay in the staging buffer (ai_scheduler.h) until then
+// so consumers only ever see fully built content.
+void update_npc_behavior_for_player(WiiPlayer* player);
+void adjust_global_difficulty(void);
+bool generate_dynamic_content_step(u32 step);
+
+#endif // GAME_STATE_H
@@ -0,0 +1,53 @@
+/*
+ * DTW gesture template matcher
+ *
+ * Banded dynamic-time-warping of the recent motion-delta window
+ * against a library of quantized gesture templates (swing variants,
+ * flicks, thrusts). Centralizes real shape recognition in the bridge
+ * so game code stops approximating it with per-title heuristics on
+ * top of the two-threshold intensity classifier. Templates live in a
+ * preprocessed binary blob loaded from SD once FAT is up; a compiled-
+ * in default library keeps matching alive without the card.
+ */
+
+#ifndef GESTURE_DTW_H
+#define GESTURE_DTW_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Library limits
+#define DTW_MAX_TEMPLATES 16
+#define DTW_MAX_TEMPLATE_LEN 24
+
+// Sakoe-Chiba band half-width: cells farther than this off the
+// diagonal are never visited, bounding each match at
+// O(len * (2*DTW_BAND + 1))
+#define DTW_BAND 4
+
+// Magnitudes quantize to u8 over [0, DTW_QUANT_RANGE] g-deltas
+#define DTW_QUANT_RANGE 2.0f
+
+// Template blob on SD: header magic "WT" u16, version u8, count u8,
+// then per template: type u8, length u8, reserved u16, length bytes
+// of quantized magnitudes.
+#define DTW_BLOB_MAGIC 0x5457  // "WT"
+#define DTW_BLOB_VERSION 1
+#define DTW_BLOB_PATH "wii_gestures.bin"
+
+// Load the template blob; falls back to the compiled-in library and
+// returns -1 when the file is missing or malformed.
+int gesture_dtw_load(const char* path);
+
+// Number of templates currently installed
+int gesture_dtw_count(void);
+
+// Match a window of accel delta magnitudes, oldest sample first,
+// against the library. Returns the winning GestureType and writes a
+// 0..1 confidence, or -1 when no template beats the acceptance cut.
+// Early-abandon pruning drops a template as soon as its band minimum
+// exceeds the best distance so far.
+int gesture_dtw_match(const float* window, int count, float* confidence);
+
+#endif // GESTURE_DTW_H
@@ -0,0 +1,27 @@
+/*
+ * Gesture feature extraction kernels
+ *
+ * Gekko paired-single implementations of the per-sample motion math
+ * (delta vectors, magnitudes) with a reciprocal-square-root path
+ * replacing libm sqrtf. Builds targeting other CPUs get a scalar
+ * fallback with identical semantics.
+ */
+
+#ifndef GESTURE_SIMD_H
+#define GESTURE_SIMD_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Magnitude of the accelerometer delta between two samples
+float gesture_delta_magnitude(const GestureSample* prev,
+                              const GestureSample* curr);
+
+// Extract accel delta magnitudes for every adjacent pair in the
+// buffer, oldest first. Returns the number of magnitudes written
+// (at most max_out).
+int gesture_extract_magnitudes(const GestureBuffer* buffer,
+                               float* out, int max_out);
+
+#endif // GESTURE_SIMD_H
@@ -0,0 +1,33 @@
+/*
+ * Input history API
+ *
+ * Push/read interface over the structure-of-arrays InputHistory ring.
+ * Window reads hand back contiguous, linearized copies of the most
+ * recent N samples (newest first), so callers never do per-element
+ * modulo arithmetic or drag unrelated fields through the cache.
+ */
+
+#ifndef INPUT_HISTORY_H
+#define INPUT_HISTORY_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Append one snapshot, scattering its fields into the per-field rings
+void input_history_push(InputHistory* history, const InputSnapshot* snapshot);
+
+// Reassemble the most recent snapshot. Returns 0 on success, -1 if
+// the history is empty.
+int input_history_latest(const InputHistory* history, InputSnapshot* out);
+
+// Reassemble the most recent n snapshots, newest first. Returns the
+// number written (min of n and the stored count).
+int input_history_window(const InputHistory* history, int n,
+                         InputSnapshot* out);
+
+// Linearize the most recent n timestamps, newest first, from the
+// dense timestamp stream. Returns the number written.
+int input_history_timestamps(const InputHistory* history, int n, u64* out);
+
+#endif // INPUT_HISTORY_H
@@ -0,0 +1,53 @@
+/*
+ * Dedicated input-sampling thread
+ *
+ * Drains WPAD's queued event interface at full device rate on its own
+ * lwp thread, folds the raw reports through an incremental decimation
+ * filter, and publishes InputSnapshot records through a lock-free
+ * single-producer/single-consumer ring per player. The main loop
+ * drains the rings into InputHistory, so motion fidelity no longer
+ * depends on render frame time, and fast swings are anti-aliased by
+ * the filter instead of sampled sparsely.
+ */
+
+#ifndef INPUT_THREAD_H
+#define INPUT_THREAD_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Ring capacity per player; power of two, sized for ~0.6 s of samples
+// at the 200 Hz sampling rate
+#define INPUT_RING_SIZE 128
+
+// Ring emit period in microseconds (200 Hz). Raw device reports can
+// arrive faster than this; every report between two emits is folded
+// into the decimation filter, so the ring rate caps downstream cost
+// while no raw sample is discarded.
+#define INPUT_SAMPLE_PERIOD_US 5000
+
+// Start the sampling thread. Returns 0 on success, -1 if the thread
+// could not be created (callers should fall back to inline sampling).
+int input_thread_start(void);
+
+// Stop the sampling thread and join it.
+void input_thread_stop(void);
+
+// True if the thread is currently sampling.
+bool input_thread_running(void);
+
+// Connection status for a channel, as last observed by the thread.
+bool input_thread_probe(int channel);
+
+// Pop the oldest unseen snapshot for a channel. Returns 1 if a
+// snapshot was written to *out, 0 if the ring is empty. Main-loop
+// (consumer) side only.
+int input_ring_pop(int channel, InputSnapshot* out);
+
+// Raw device reports ingested since start, across all channels.
+// Diagnostic: compare against ring emits to see the effective
+// oversampling ratio.
+u32 input_thread_raw_samples(void);
+
+#endif // INPUT_THREAD_H
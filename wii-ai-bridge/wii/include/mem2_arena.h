@@ -0,0 +1,35 @@
+/*
+ * MEM2 arena allocator
+ *
+ * Simple bump allocator carved out of the Wii's MEM2 region at bridge
+ * init. The AI path grabs its long-lived, cache-line-aligned slots
+ * (pending batch, encode buffer, receive buffer) once and never
+ * allocates again, so per-frame work is zero-allocation. Builds
+ * without MEM2 (host simulation) fall back to a static backing buffer
+ * with the same interface.
+ */
+
+#ifndef MEM2_ARENA_H
+#define MEM2_ARENA_H
+
+#include <gccore.h>
+
+// Arena capacity reserved for the bridge
+#define MEM2_ARENA_SIZE (64 * 1024)
+
+// Gekko/Broadway cache line size; default slot alignment
+#define MEM2_CACHE_LINE 32
+
+// Initialize the arena. Returns 0 on success, -1 if the backing
+// memory could not be reserved.
+int mem2_arena_init(void);
+
+// Bump-allocate size bytes at the given alignment (power of two).
+// Returns NULL when the arena is exhausted. There is no free: slots
+// are grabbed at init and live for the bridge's lifetime.
+void* mem2_arena_alloc(u32 size, u32 align);
+
+// Bytes still available.
+u32 mem2_arena_remaining(void);
+
+#endif // MEM2_ARENA_H
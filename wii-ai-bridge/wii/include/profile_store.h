@@ -0,0 +1,46 @@
+/*
+ * Persistent binary player-profile store
+ *
+ * Returning players used to restart at skill 0.5 / "balanced" every
+ * boot and pay minutes of cold-start adaptation. The store keeps one
+ * compact fixed-layout binary file per player on the FAT mount:
+ * loaded with a single read (no parsing) in wii_ai_bridge_init(),
+ * checkpointed periodically by a background lwp writer so learned
+ * state survives a power cut, and flushed once more at cleanup.
+ */
+
+#ifndef PROFILE_STORE_H
+#define PROFILE_STORE_H
+
+#include <gccore.h>
+#include "wii_interface.h"
+
+#define PROFILE_STORE_VERSION 1
+
+// On-disk record: 48 bytes, little-endian, fixed layout
+//   u16 magic "WP", u8 version, u8 pad
+//   f32 skill_level, learning_rate, adaptation_speed
+//   f32 timing_mean_us, timing_var_us2, consistency
+//   char play_style[16], u32 reserved
+#define PROFILE_RECORD_SIZE 48
+
+// Frames between checkpoints (~30 s at 60 FPS). Writes happen on the
+// background writer thread, never on the frame loop.
+#define PROFILE_CHECKPOINT_FRAMES 1800
+
+// Start the background writer. Returns 0 on success.
+int profile_store_start(void);
+
+// Flush any learned state and stop the writer.
+void profile_store_stop(WiiPlayer* players);
+
+// Load a player's saved profile into their bridge state. Returns 0
+// when a valid record was applied, -1 for a missing or bad file
+// (the caller's defaults stand).
+int profile_store_load(int player_id, WiiPlayer* player);
+
+// Called once per frame: snapshots all profiles for the writer every
+// PROFILE_CHECKPOINT_FRAMES frames.
+void profile_store_tick(u32 frame, WiiPlayer* players);
+
+#endif // PROFILE_STORE_H
@@ -0,0 +1,56 @@
+/*
+ * Hot-path phase instrumentation
+ *
+ * Time-base samples around each phase of wii_ai_bridge_update(),
+ * accumulated into a fixed ring of per-frame phase timings with
+ * min/max/avg/p99 rollups on query. Cheap enough to leave enabled:
+ * two gettime() calls per phase, no allocation, no I/O on the hot
+ * path. The ring can be dumped to SD (CSV) for offline analysis.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <gccore.h>
+
+// Frame phases measured inside wii_ai_bridge_update()
+typedef enum {
+    PROF_PHASE_NET_POLL = 0,   // poll_ai_responses
+    PROF_PHASE_INPUT,          // ring drain / WPAD scan + ingest
+    PROF_PHASE_AI,             // batch assembly, send, deadline path
+    PROF_PHASE_GAME_AI,        // update_game_ai
+    PROF_PHASE_COUNT
+} ProfPhase;
+
+// Frames retained in the timing ring (~4.3 s at 60 FPS)
+#define PROF_RING_FRAMES 256
+
+// Rollup statistics for one phase over the retained window, in the
+// gettime() unit (ticks on Gekko, ns on host)
+typedef struct {
+    u32 min;
+    u32 max;
+    u32 avg;
+    u32 p99;
+    u32 frames;  // frames in the window
+} ProfStats;
+
+// Enable/disable sampling (enabled by default)
+void prof_set_enabled(bool enabled);
+bool prof_enabled(void);
+
+// Phase bracketing, called from the frame loop
+void prof_frame_begin(void);
+void prof_phase_begin(ProfPhase phase);
+void prof_phase_end(ProfPhase phase);
+void prof_frame_end(void);
+
+// Roll up one phase over the retained window. Returns 0 on success,
+// -1 if no frames have been recorded.
+int prof_query(ProfPhase phase, ProfStats* out);
+
+// Dump the per-frame ring as CSV (one row per frame, one column per
+// phase). Returns 0 on success.
+int prof_dump(const char* path);
+
+#endif // PROFILER_H
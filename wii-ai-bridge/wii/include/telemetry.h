@@ -0,0 +1,81 @@
+/*
+ * Always-on cabinet telemetry
+ *
+ * Field cabinets have no USB Gecko, so printf visibility stops at the
+ * bench. This module pre-aggregates the bridge's health counters —
+ * frame-time histogram, AI round-trip RTT, cache-hit rate, gesture
+ * distribution, retransmits and fallbacks — incrementally at sample
+ * time, and once per second packs them into one compact little-endian
+ * datagram sent to the collector over the existing AI socket. The
+ * per-second emit is just the pack and a non-blocking sendto; the
+ * per-sample cost is a counter increment (the histogram bucket index
+ * is a count-leading-zeros, no float math anywhere on the hot path).
+ *
+ * All values are free-running totals: the collector diffs successive
+ * datagrams, so a lost datagram loses resolution, never correctness.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <gccore.h>
+
+#include "wii_interface.h"
+
+// Collector endpoint (same host as the AI engine, separate port)
+#define TELEMETRY_COLLECTOR_IP   "192.168.1.100"
+#define TELEMETRY_COLLECTOR_PORT 9090
+
+// One datagram per second at 60 FPS
+#define TELEMETRY_EMIT_FRAMES 60
+
+// Datagram identification
+#define TELEMETRY_MAGIC   0x4D57  // "WM"
+#define TELEMETRY_VERSION 1
+
+// Frame-time histogram: bucket i covers [2^i, 2^(i+1)) microseconds,
+// so bucket 14 alone flags frames past ~16 ms
+#define TELEMETRY_HIST_BUCKETS 16
+
+// Event counters carried in the datagram, in wire order
+typedef enum {
+    TELEM_BATCHES_SENT = 0,   // AI batches transmitted
+    TELEM_ROUND_TRIPS,        // replies matched to an in-flight batch
+    TELEM_CACHE_HITS,         // response-cache hits (no send needed)
+    TELEM_RETRANSMITS,        // halfway-point retransmits
+    TELEM_STALE_REPLIES,      // replies for superseded sequences
+    TELEM_LOCAL_FALLBACKS,    // batches expired to the local AI
+    TELEM_COUNTER_COUNT
+} TelemetryCounter;
+
+// Datagram layout (little-endian):
+//   u16 magic, u8 version, u8 pad, u32 frame,
+//   u32 srtt_us, u32 rttvar_us,
+//   u32 counters[TELEM_COUNTER_COUNT],
+//   u32 gesture_counts[6],
+//   u32 frames_sampled, u32 hist[TELEMETRY_HIST_BUCKETS]
+#define TELEMETRY_DATAGRAM_SIZE \
+    (4 + 4 + 8 + TELEM_COUNTER_COUNT * 4 + 6 * 4 + 4 + \
+     TELEMETRY_HIST_BUCKETS * 4)
+
+// Zero all aggregates (bridge init)
+void telemetry_reset(void);
+
+// Bump an event counter (hot path, one increment)
+void telemetry_count(TelemetryCounter counter);
+
+// Record a classified gesture window into the distribution
+void telemetry_count_gesture(int gesture_type);
+
+// Fold one frame's wall time into the histogram (integer-only)
+void telemetry_frame_time(u32 frame_us);
+
+// Per-frame tick from the frame loop: every TELEMETRY_EMIT_FRAMES
+// frames, packs the aggregates and sends them on sock. Does nothing
+// while sock < 0. net carries the RTT estimate to embed.
+void telemetry_tick(u32 frame, s32 sock, const AINetworkStats* net);
+
+// Datagrams emitted since reset (diagnostics)
+u32 telemetry_emit_count(void);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,51 @@
+/*
+ * Binary input trace recorder
+ *
+ * Opt-in capture of raw input into a compact binary log on SD (via
+ * the FAT mount from wii_ai_bridge_init()). Records accumulate in two
+ * alternating in-memory buffers; a background lwp thread flushes the
+ * full one while the frame loop keeps filling the other, so recording
+ * never blocks the 60 FPS path. If SD can't keep up, whole records
+ * are dropped and counted rather than stalling.
+ *
+ * The on-disk format is a flat little-endian array of TraceRecord —
+ * the same layout the host simulator and benchmark suite replay with
+ * host_sim_load_trace().
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <gccore.h>
+#include "wii_interface.h"
+
+// One logged input record, 32 bytes, little-endian on disk
+typedef struct {
+    u8 channel;
+    u8 gyro_valid;
+    u16 reserved;
+    u32 buttons;
+    float accel[3];
+    float gyro[3];
+} TraceRecord;
+
+#define TRACE_RECORD_SIZE 32
+
+// Records per write buffer (two buffers; 16 KB each)
+#define TRACE_BUFFER_RECORDS 512
+
+// Open the log and start the flush thread. Returns 0 on success.
+int trace_recorder_start(const char* path);
+
+// Flush everything captured so far, stop the thread, close the log.
+void trace_recorder_stop(void);
+
+bool trace_recorder_active(void);
+
+// Append one record (called from the input ingest path; no I/O).
+void trace_recorder_capture(int channel, const InputSnapshot* snap);
+
+// Records dropped because both buffers were full (SD too slow).
+u32 trace_recorder_dropped(void);
+
+#endif // TRACE_RECORDER_H
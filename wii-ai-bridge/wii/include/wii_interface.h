@@ -0,0 +1,199 @@
+/*
+ * Wii Interface definitions for AI Gaming Bridge
+ *
+ * Input capture, gesture recognition and player state types shared
+ * between the bridge core and game-side code.
+ */
+
+#ifndef WII_INTERFACE_H
+#define WII_INTERFACE_H
+
+#include <gccore.h>
+
+// Shared limits
+#define MAX_PLAYERS 4
+#define INPUT_HISTORY_SIZE 64
+#define GESTURE_BUFFER_SIZE 32
+#define AI_PLAY_STYLE_LEN 16
+
+// Gesture classification results
+typedef enum {
+    GESTURE_IDLE = 0,
+    GESTURE_POINT,
+    GESTURE_SWING,
+    GESTURE_SHAKE,
+    GESTURE_TILT,
+    GESTURE_THRUST
+} GestureType;
+
+// Accelerometer reading (normalized)
+typedef struct {
+    float x;
+    float y;
+    float z;
+} AccelData;
+
+// IR pointer reading
+typedef struct {
+    bool valid;
+    float x;
+    float y;
+    float angle;
+} IRData;
+
+// Motion Plus gyroscope reading
+typedef struct {
+    bool valid;
+    float pitch;
+    float roll;
+    float yaw;
+} GyroData;
+
+// Single frame of Wii Remote input
+typedef struct {
+    u32 buttons_held;
+    u32 buttons_pressed;
+    u32 buttons_released;
+    AccelData accel;
+    IRData ir;
+    GyroData gyro;
+    u64 timestamp;
+} InputSnapshot;
+
+// Ring buffer of recent input, structure-of-arrays layout.
+//
+// Each field stream is a dense ring of its own so scans that need one
+// field (e.g. timestamp-only consistency passes) touch one contiguous
+// array instead of striding whole snapshots through the cache. Use
+// the input_history_* API (input_history.h) to push samples and to
+// get linearized most-recent-N views.
+typedef struct {
+    u32 buttons_held[INPUT_HISTORY_SIZE];
+    u32 buttons_pressed[INPUT_HISTORY_SIZE];
+    u32 buttons_released[INPUT_HISTORY_SIZE];
+    float accel_x[INPUT_HISTORY_SIZE];
+    float accel_y[INPUT_HISTORY_SIZE];
+    float accel_z[INPUT_HISTORY_SIZE];
+    float ir_x[INPUT_HISTORY_SIZE];
+    float ir_y[INPUT_HISTORY_SIZE];
+    float ir_angle[INPUT_HISTORY_SIZE];
+    float gyro_pitch[INPUT_HISTORY_SIZE];
+    float gyro_roll[INPUT_HISTORY_SIZE];
+    float gyro_yaw[INPUT_HISTORY_SIZE];
+    u8 ir_valid[INPUT_HISTORY_SIZE];
+    u8 gyro_valid[INPUT_HISTORY_SIZE];
+    u64 timestamps[INPUT_HISTORY_SIZE];
+    int write_index;
+    int count;
+} InputHistory;
+
+// Single motion sample used for gesture recognition
+typedef struct {
+    float accel_x;
+    float accel_y;
+    float accel_z;
+    float gyro_pitch;
+    float gyro_roll;
+    float gyro_yaw;
+    u64 timestamp;
+} GestureSample;
+
+// Ring buffer of motion samples for one player.
+//
+// Running motion statistics are maintained incrementally as samples
+// arrive (see update_gesture_buffer), so classification is an O(1)
+// read no matter how large the buffer grows. delta_magnitudes[i] holds
+// the accel delta magnitude between samples[i] and its predecessor.
+typedef struct {
+    GestureSample samples[GESTURE_BUFFER_SIZE];
+    int write_index;
+    int sample_count;
+
+    // Incremental statistics over the inter-sample delta magnitudes
+    float delta_magnitudes[GESTURE_BUFFER_SIZE];
+    int delta_count;
+    float motion_sum;
+    float motion_sq_sum;
+    float motion_peak;
+} GestureBuffer;
+
+// Result of analyzing a gesture buffer
+typedef struct {
+    GestureType type;
+    float intensity;
+    float confidence;
+} GestureAnalysis;
+
+// Per-player AI adaptation parameters
+typedef struct {
+    float skill_level;
+    float learning_rate;
+    float adaptation_speed;
+    char play_style[AI_PLAY_STYLE_LEN];
+} AIProfile;
+
+// Streaming input-timing estimator, updated as each snapshot is
+// ingested: exponentially weighted mean/variance of the gap between
+// inputs, and a derived 0..1 consistency score. Reading it is O(1) —
+// no window rescan — and the exponential horizon is much longer than
+// the 5-sample request window, so downstream controllers see a far
+// steadier signal.
+typedef struct {
+    bool seeded;
+    u64 last_timestamp;
+    float timing_mean_us;   // EW mean of inter-input gaps
+    float timing_var_us2;   // EW variance of inter-input gaps
+    float consistency;      // 1 - coefficient of variation, clamped
+} InputTimingStats;
+
+// Complete per-player bridge state
+typedef struct {
+    int id;
+    bool connected;
+    float skill_level;      // EWMA, see update_skill_estimation()
+    float ai_assistance_level;
+    InputHistory input_history;
+    InputTimingStats timing;
+    AIProfile ai_profile;
+} WiiPlayer;
+
+// Enhanced input handed back to game logic
+typedef struct {
+    u32 buttons;
+    AccelData accel;
+    IRData ir;
+    GyroData gyro;
+    GestureType predicted_gesture;
+    float gesture_confidence;
+} WiiInput;
+
+// Bring-up status of the slow init subsystems. FAT mounting and
+// net_init (DHCP) run on background threads so the frame loop can
+// start immediately; the game polls these to render during bring-up.
+typedef enum {
+    BRIDGE_SUBSYS_PENDING = 0,
+    BRIDGE_SUBSYS_READY,
+    BRIDGE_SUBSYS_FAILED
+} BridgeSubsysState;
+
+// Network health snapshot for per-cabinet instrumentation: smoothed
+// round-trip estimate over the AI request/reply exchange plus the
+// reliability layer's counters
+typedef struct {
+    bool rtt_valid;     // false until the first reply is measured
+    float srtt_us;      // smoothed RTT
+    float rttvar_us;    // smoothed RTT deviation
+    u32 retransmits;
+    u32 stale_replies;
+} AINetworkStats;
+
+// Public bridge API
+int wii_ai_bridge_init(void);
+void wii_ai_bridge_update(void);
+void wii_ai_bridge_cleanup(void);
+WiiInput wii_ai_get_enhanced_input(int player_id);
+BridgeSubsysState wii_ai_bridge_fat_state(void);
+BridgeSubsysState wii_ai_bridge_net_state(void);
+AINetworkStats wii_ai_get_network_stats(void);
+
+#endif // WII_INTERFACE_H
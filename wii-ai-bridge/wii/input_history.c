@@ -0,0 +1,88 @@
+/*
+ * Input history implementation
+ *
+ * The ring index math happens once per call here; every returned view
+ * is a dense, newest-first copy the caller can walk linearly.
+ */
+
+#include <string.h>
+
+#include "input_history.h"
+
+void input_history_push(InputHistory* history, const InputSnapshot* snapshot) {
+    int w = history->write_index;
+
+    history->buttons_held[w] = snapshot->buttons_held;
+    history->buttons_pressed[w] = snapshot->buttons_pressed;
+    history->buttons_released[w] = snapshot->buttons_released;
+    history->accel_x[w] = snapshot->accel.x;
+    history->accel_y[w] = snapshot->accel.y;
+    history->accel_z[w] = snapshot->accel.z;
+    history->ir_x[w] = snapshot->ir.x;
+    history->ir_y[w] = snapshot->ir.y;
+    history->ir_angle[w] = snapshot->ir.angle;
+    history->ir_valid[w] = snapshot->ir.valid ? 1 : 0;
+    history->gyro_pitch[w] = snapshot->gyro.pitch;
+    history->gyro_roll[w] = snapshot->gyro.roll;
+    history->gyro_yaw[w] = snapshot->gyro.yaw;
+    history->gyro_valid[w] = snapshot->gyro.valid ? 1 : 0;
+    history->timestamps[w] = snapshot->timestamp;
+
+    history->write_index = (w + 1) % INPUT_HISTORY_SIZE;
+    if (history->count < INPUT_HISTORY_SIZE) {
+        history->count++;
+    }
+}
+
+/*
+ * Gather one snapshot back out of the field streams
+ */
+static void gather_snapshot(const InputHistory* history, int idx,
+                            InputSnapshot* out) {
+    out->buttons_held = history->buttons_held[idx];
+    out->buttons_pressed = history->buttons_pressed[idx];
+    out->buttons_released = history->buttons_released[idx];
+    out->accel.x = history->accel_x[idx];
+    out->accel.y = history->accel_y[idx];
+    out->accel.z = history->accel_z[idx];
+    out->ir.x = history->ir_x[idx];
+    out->ir.y = history->ir_y[idx];
+    out->ir.angle = history->ir_angle[idx];
+    out->ir.valid = history->ir_valid[idx] != 0;
+    out->gyro.pitch = history->gyro_pitch[idx];
+    out->gyro.roll = history->gyro_roll[idx];
+    out->gyro.yaw = history->gyro_yaw[idx];
+    out->gyro.valid = history->gyro_valid[idx] != 0;
+    out->timestamp = history->timestamps[idx];
+}
+
+int input_history_latest(const InputHistory* history, InputSnapshot* out) {
+    if (history->count == 0) return -1;
+
+    int idx = (history->write_index - 1 + INPUT_HISTORY_SIZE) % INPUT_HISTORY_SIZE;
+    gather_snapshot(history, idx, out);
+    return 0;
+}
+
+int input_history_window(const InputHistory* history, int n,
+                         InputSnapshot* out) {
+    if (n > history->count) n = history->count;
+
+    for (int i = 0; i < n; i++) {
+        int idx = (history->write_index - i - 1 + INPUT_HISTORY_SIZE)
+                  % INPUT_HISTORY_SIZE;
+        gather_snapshot(history, idx, &out[i]);
+    }
+    return n;
+}
+
+int input_history_timestamps(const InputHistory* history, int n, u64* out) {
+    if (n > history->count) n = history->count;
+
+    for (int i = 0; i < n; i++) {
+        int idx = (history->write_index - i - 1 + INPUT_HISTORY_SIZE)
+                  % INPUT_HISTORY_SIZE;
+        out[i] = history->timestamps[idx];
+    }
+    return n;
+}
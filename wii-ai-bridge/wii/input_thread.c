@@ -0,0 +1,236 @@
+/*
+ * Dedicated input-sampling thread implementation
+ *
+ * One producer (the sampling thread) and one consumer (the main loop)
+ * per ring, so the rings need no locks: the producer only writes
+ * head, the consumer only writes tail, and both indices are free-
+ * running u32s masked on access. A full ring drops the newest sample
+ * rather than stalling the sampler.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <gccore.h>
+#include <wiiuse/wpad.h>
+
+#include "input_thread.h"
+
+// Lock-free SPSC ring of input snapshots
+typedef struct {
+    InputSnapshot slots[INPUT_RING_SIZE];
+    vu32 head;  // producer-owned
+    vu32 tail;  // consumer-owned
+} InputRing;
+
+static InputRing input_rings[MAX_PLAYERS];
+static volatile bool channel_connected[MAX_PLAYERS];
+
+static lwp_t sampler_thread = LWP_THREAD_NULL;
+static volatile bool sampler_running = false;
+static u8 sampler_stack[16 * 1024] ATTRIBUTE_ALIGN(8);
+
+/*
+ * Incremental decimation state, one per channel. Every raw device
+ * report folds into the sums; one filtered snapshot is emitted per
+ * ring period. Averaging over the window is the anti-aliasing filter:
+ * it costs one add per axis per report and a handful of multiplies at
+ * emit time. Button edges are OR-accumulated so a press shorter than
+ * the emit period still reaches the consumer.
+ */
+typedef struct {
+    float accel_sum[3];
+    float gyro_sum[3];
+    float ir_sum[2];
+    float ir_angle_sum;
+    u32 report_count;
+    u32 gyro_count;
+    u32 ir_count;
+    u32 buttons_held;       // held mask from the newest report
+    u32 buttons_pressed;    // OR of edges across the window
+    u32 buttons_released;
+} InputDecimator;
+
+static InputDecimator decimators[MAX_PLAYERS];
+static u32 raw_sample_count = 0;
+
+/*
+ * Fold one raw WPAD report into a channel's decimator (producer side,
+ * called from the WPAD event drain at full device rate)
+ */
+static void ingest_report(s32 chan, const WPADData* data) {
+    if (chan < 0 || chan >= MAX_PLAYERS) return;
+
+    InputDecimator* dec = &decimators[chan];
+    dec->accel_sum[0] += data->accel.x;
+    dec->accel_sum[1] += data->accel.y;
+    dec->accel_sum[2] += data->accel.z;
+    dec->report_count++;
+
+    dec->buttons_held = data->btns_h;
+    dec->buttons_pressed |= data->btns_d;
+    dec->buttons_released |= data->btns_u;
+
+    if (data->ir.valid) {
+        dec->ir_sum[0] += data->ir.x;
+        dec->ir_sum[1] += data->ir.y;
+        dec->ir_angle_sum += data->ir.angle;
+        dec->ir_count++;
+    }
+
+    if (data->exp.type == WPAD_EXP_MOTION_PLUS) {
+        dec->gyro_sum[0] += data->exp.mp.pitch;
+        dec->gyro_sum[1] += data->exp.mp.roll;
+        dec->gyro_sum[2] += data->exp.mp.yaw;
+        dec->gyro_count++;
+    }
+
+    raw_sample_count++;
+}
+
+/*
+ * Collapse a channel's decimation window into one snapshot and reset
+ * it. Returns false if no reports arrived this window.
+ */
+static bool emit_decimated(int chan, InputSnapshot* snap) {
+    InputDecimator* dec = &decimators[chan];
+    if (dec->report_count == 0) return false;
+
+    float inv = 1.0f / (float)dec->report_count;
+    snap->accel.x = dec->accel_sum[0] * inv;
+    snap->accel.y = dec->accel_sum[1] * inv;
+    snap->accel.z = dec->accel_sum[2] * inv;
+
+    snap->buttons_held = dec->buttons_held;
+    snap->buttons_pressed = dec->buttons_pressed;
+    snap->buttons_released = dec->buttons_released;
+
+    if (dec->ir_count > 0) {
+        float ir_inv = 1.0f / (float)dec->ir_count;
+        snap->ir.valid = true;
+        snap->ir.x = dec->ir_sum[0] * ir_inv;
+        snap->ir.y = dec->ir_sum[1] * ir_inv;
+        snap->ir.angle = dec->ir_angle_sum * ir_inv;
+    } else {
+        snap->ir.valid = false;
+    }
+
+    if (dec->gyro_count > 0) {
+        float gyro_inv = 1.0f / (float)dec->gyro_count;
+        snap->gyro.valid = true;
+        snap->gyro.pitch = dec->gyro_sum[0] * gyro_inv;
+        snap->gyro.roll = dec->gyro_sum[1] * gyro_inv;
+        snap->gyro.yaw = dec->gyro_sum[2] * gyro_inv;
+    } else {
+        snap->gyro.valid = false;
+    }
+
+    snap->timestamp = gettime();
+
+    memset(dec, 0, sizeof(*dec));
+    return true;
+}
+
+/*
+ * Push a snapshot into a ring (producer side). Drops the sample if
+ * the consumer has fallen a full ring behind.
+ */
+static void ring_push(InputRing* ring, const InputSnapshot* snap) {
+    u32 head = ring->head;
+    if (head - ring->tail >= INPUT_RING_SIZE) {
+        return;  // consumer stalled: drop rather than block
+    }
+    memcpy(&ring->slots[head % INPUT_RING_SIZE], snap, sizeof(InputSnapshot));
+    // Publish the slot before the index so the consumer never reads a
+    // half-written snapshot
+    ring->head = head + 1;
+}
+
+/*
+ * Pop the oldest snapshot (consumer side)
+ */
+int input_ring_pop(int channel, InputSnapshot* out) {
+    if (channel < 0 || channel >= MAX_PLAYERS) return 0;
+
+    InputRing* ring = &input_rings[channel];
+    u32 tail = ring->tail;
+    if (tail == ring->head) {
+        return 0;
+    }
+    memcpy(out, &ring->slots[tail % INPUT_RING_SIZE], sizeof(InputSnapshot));
+    ring->tail = tail + 1;
+    return 1;
+}
+
+/*
+ * Sampling thread entry: drain every queued WPAD report at full
+ * device rate, then emit one decimated snapshot per channel per ring
+ * period
+ */
+static void* sampler_main(void* arg) {
+    (void)arg;
+
+    while (sampler_running) {
+        WPAD_ReadPending(WPAD_CHAN_ALL, ingest_report);
+
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            bool connected = (WPAD_Probe(i, NULL) == WPAD_ERR_NONE);
+            channel_connected[i] = connected;
+            if (!connected) {
+                memset(&decimators[i], 0, sizeof(decimators[i]));
+                continue;
+            }
+
+            InputSnapshot snap;
+            if (emit_decimated(i, &snap)) {
+                ring_push(&input_rings[i], &snap);
+            }
+        }
+
+        usleep(INPUT_SAMPLE_PERIOD_US);
+    }
+
+    return NULL;
+}
+
+int input_thread_start(void) {
+    if (sampler_running) return 0;
+
+    memset(input_rings, 0, sizeof(input_rings));
+    memset((void*)channel_connected, 0, sizeof(channel_connected));
+    memset(decimators, 0, sizeof(decimators));
+    raw_sample_count = 0;
+    sampler_running = true;
+
+    if (LWP_CreateThread(&sampler_thread, sampler_main, NULL,
+                         sampler_stack, sizeof(sampler_stack), 80) < 0) {
+        sampler_running = false;
+        printf("Input thread creation failed\n");
+        return -1;
+    }
+
+    printf("Input sampling thread started (full-rate ingest, %d Hz emit)\n",
+           1000000 / INPUT_SAMPLE_PERIOD_US);
+    return 0;
+}
+
+void input_thread_stop(void) {
+    if (!sampler_running) return;
+
+    sampler_running = false;
+    LWP_JoinThread(sampler_thread, NULL);
+    sampler_thread = LWP_THREAD_NULL;
+}
+
+bool input_thread_running(void) {
+    return sampler_running;
+}
+
+bool input_thread_probe(int channel) {
+    if (channel < 0 || channel >= MAX_PLAYERS) return false;
+    return channel_connected[channel];
+}
+
+u32 input_thread_raw_samples(void) {
+    return raw_sample_count;
+}
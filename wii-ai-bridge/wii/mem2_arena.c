@@ -0,0 +1,56 @@
+/*
+ * MEM2 arena allocator implementation
+ */
+
+#include <stdio.h>
+
+#include "mem2_arena.h"
+
+static u8* arena_base = NULL;
+static u32 arena_offset = 0;
+static u32 arena_size = 0;
+
+#ifndef HW_RVL
+// No MEM2 on host builds: back the arena with static storage instead
+static u8 arena_backing[MEM2_ARENA_SIZE]
+    __attribute__((aligned(MEM2_CACHE_LINE)));
+#endif
+
+int mem2_arena_init(void) {
+    if (arena_base) return 0;
+
+#ifdef HW_RVL
+    arena_base = (u8*)SYS_AllocArena2MemLo(MEM2_ARENA_SIZE, MEM2_CACHE_LINE);
+    if (!arena_base) {
+        printf("MEM2 arena allocation failed\n");
+        return -1;
+    }
+#else
+    arena_base = arena_backing;
+#endif
+
+    arena_offset = 0;
+    arena_size = MEM2_ARENA_SIZE;
+    printf("MEM2 arena: %u KB reserved\n", arena_size / 1024);
+    return 0;
+}
+
+void* mem2_arena_alloc(u32 size, u32 align) {
+    if (!arena_base || align == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+
+    u32 aligned = (arena_offset + align - 1) & ~(align - 1);
+    if (aligned + size > arena_size) {
+        printf("MEM2 arena exhausted (%u bytes requested)\n", size);
+        return NULL;
+    }
+
+    arena_offset = aligned + size;
+    return arena_base + aligned;
+}
+
+u32 mem2_arena_remaining(void) {
+    if (!arena_base) return 0;
+    return arena_size - arena_offset;
+}
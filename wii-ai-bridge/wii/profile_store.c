@@ -0,0 +1,177 @@
+/*
+ * Persistent profile store implementation
+ *
+ * Same single-producer/single-consumer shape as the trace recorder:
+ * the frame loop snapshots encoded records into a pending buffer and
+ * raises a flag; the writer thread owns all file I/O. Records are
+ * explicit little-endian bytes so the files are identical across the
+ * Gekko and host builds.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <gccore.h>
+
+#include "profile_store.h"
+
+#define PROFILE_MAGIC 0x5057  // "WP"
+#define PROFILE_PATH_FMT "wii_profile_%d.bin"
+#define PROFILE_FLUSH_POLL_US 50000
+
+static inline void store_u16(u8* p, u16 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)(v >> 8);
+}
+
+static inline void store_u32(u8* p, u32 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)((v >> 8) & 0xFF);
+    p[2] = (u8)((v >> 16) & 0xFF);
+    p[3] = (u8)((v >> 24) & 0xFF);
+}
+
+static inline void store_f32(u8* p, float v) {
+    u32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    store_u32(p, bits);
+}
+
+static inline u16 load_u16(const u8* p) {
+    return (u16)(p[0] | (p[1] << 8));
+}
+
+static inline u32 load_u32(const u8* p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static inline float load_f32(const u8* p) {
+    u32 bits = load_u32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Snapshot handed from the frame loop to the writer thread
+static u8 pending_records[MAX_PLAYERS][PROFILE_RECORD_SIZE];
+static volatile bool pending_write = false;
+
+static volatile bool writer_running = false;
+static lwp_t writer_thread = LWP_THREAD_NULL;
+static u8 writer_stack[16 * 1024] ATTRIBUTE_ALIGN(8);
+
+static void encode_record(u8* rec, const WiiPlayer* player) {
+    memset(rec, 0, PROFILE_RECORD_SIZE);
+    store_u16(rec, PROFILE_MAGIC);
+    rec[2] = PROFILE_STORE_VERSION;
+    store_f32(rec + 4, player->skill_level);
+    store_f32(rec + 8, player->ai_profile.learning_rate);
+    store_f32(rec + 12, player->ai_profile.adaptation_speed);
+    store_f32(rec + 16, player->timing.timing_mean_us);
+    store_f32(rec + 20, player->timing.timing_var_us2);
+    store_f32(rec + 24, player->timing.consistency);
+    memcpy(rec + 28, player->ai_profile.play_style, AI_PLAY_STYLE_LEN);
+}
+
+static void write_records(void) {
+    char path[32];
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        snprintf(path, sizeof(path), PROFILE_PATH_FMT, i);
+        FILE* f = fopen(path, "wb");
+        if (!f) continue;
+        fwrite(pending_records[i], 1, PROFILE_RECORD_SIZE, f);
+        fclose(f);
+    }
+}
+
+static void* writer_main(void* arg) {
+    (void)arg;
+
+    while (writer_running) {
+        if (pending_write) {
+            // Clear only after the write completes: the frame loop's
+            // tick skips while the flag is set, so it can never
+            // re-encode the records mid-fwrite
+            write_records();
+            pending_write = false;
+        }
+        usleep(PROFILE_FLUSH_POLL_US);
+    }
+    if (pending_write) {
+        write_records();
+    }
+    return NULL;
+}
+
+int profile_store_start(void) {
+    if (writer_running) return 0;
+
+    pending_write = false;
+    writer_running = true;
+    if (LWP_CreateThread(&writer_thread, writer_main, NULL,
+                         writer_stack, sizeof(writer_stack), 60) < 0) {
+        writer_running = false;
+        printf("Profile store: writer thread creation failed\n");
+        return -1;
+    }
+    return 0;
+}
+
+void profile_store_stop(WiiPlayer* players) {
+    if (!writer_running) return;
+
+    // Final snapshot so the last session's learning isn't lost
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        encode_record(pending_records[i], &players[i]);
+    }
+    pending_write = true;
+
+    writer_running = false;
+    LWP_JoinThread(writer_thread, NULL);
+    writer_thread = LWP_THREAD_NULL;
+}
+
+int profile_store_load(int player_id, WiiPlayer* player) {
+    char path[32];
+    snprintf(path, sizeof(path), PROFILE_PATH_FMT, player_id);
+
+    u8 rec[PROFILE_RECORD_SIZE];
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    size_t got = fread(rec, 1, PROFILE_RECORD_SIZE, f);
+    fclose(f);
+
+    if (got != PROFILE_RECORD_SIZE ||
+        load_u16(rec) != PROFILE_MAGIC ||
+        rec[2] != PROFILE_STORE_VERSION) {
+        return -1;
+    }
+
+    player->skill_level = load_f32(rec + 4);
+    player->ai_profile.skill_level = player->skill_level;
+    player->ai_profile.learning_rate = load_f32(rec + 8);
+    player->ai_profile.adaptation_speed = load_f32(rec + 12);
+    player->timing.timing_mean_us = load_f32(rec + 16);
+    player->timing.timing_var_us2 = load_f32(rec + 20);
+    player->timing.consistency = load_f32(rec + 24);
+    memcpy(player->ai_profile.play_style, rec + 28, AI_PLAY_STYLE_LEN);
+    player->ai_profile.play_style[AI_PLAY_STYLE_LEN - 1] = '\0';
+
+    printf("Player %d profile restored (skill %.2f)\n",
+           player_id, player->skill_level);
+    return 0;
+}
+
+void profile_store_tick(u32 frame, WiiPlayer* players) {
+    if (!writer_running) return;
+    if (frame == 0 || frame % PROFILE_CHECKPOINT_FRAMES != 0) return;
+
+    // Don't snapshot over a buffer the writer hasn't picked up yet;
+    // the next checkpoint will catch up
+    if (pending_write) return;
+
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        encode_record(pending_records[i], &players[i]);
+    }
+    pending_write = true;
+}
@@ -0,0 +1,123 @@
+/*
+ * Hot-path phase instrumentation implementation
+ *
+ * The hot path only stores raw interval samples into the ring; all
+ * rollup math (including the p99 sort) happens in prof_query(), which
+ * is called from tools and debug overlays, not the frame loop.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+
+static const char* phase_names[PROF_PHASE_COUNT] = {
+    "net_poll", "input", "ai", "game_ai"
+};
+
+static u32 ring[PROF_RING_FRAMES][PROF_PHASE_COUNT];
+static u32 ring_frame = 0;       // next slot to write
+static u32 frames_recorded = 0;
+
+static bool enabled = true;
+static u64 phase_start[PROF_PHASE_COUNT];
+static u32 current_frame[PROF_PHASE_COUNT];
+
+void prof_set_enabled(bool on) {
+    enabled = on;
+}
+
+bool prof_enabled(void) {
+    return enabled;
+}
+
+void prof_frame_begin(void) {
+    if (!enabled) return;
+    memset(current_frame, 0, sizeof(current_frame));
+}
+
+void prof_phase_begin(ProfPhase phase) {
+    if (!enabled) return;
+    phase_start[phase] = gettime();
+}
+
+void prof_phase_end(ProfPhase phase) {
+    if (!enabled) return;
+    // Accumulate: a phase may run in several bursts within one frame
+    current_frame[phase] += (u32)(gettime() - phase_start[phase]);
+}
+
+void prof_frame_end(void) {
+    if (!enabled) return;
+
+    memcpy(ring[ring_frame], current_frame, sizeof(current_frame));
+    ring_frame = (ring_frame + 1) % PROF_RING_FRAMES;
+    if (frames_recorded < PROF_RING_FRAMES) {
+        frames_recorded++;
+    }
+}
+
+int prof_query(ProfPhase phase, ProfStats* out) {
+    if (frames_recorded == 0) return -1;
+
+    u32 samples[PROF_RING_FRAMES];
+    u32 n = frames_recorded;
+    u64 sum = 0;
+    u32 min = 0xFFFFFFFF, max = 0;
+
+    for (u32 i = 0; i < n; i++) {
+        u32 v = ring[i][phase];
+        samples[i] = v;
+        sum += v;
+        if (v < min) min = v;
+        if (v > max) max = v;
+    }
+
+    // Insertion sort is fine for 256 samples off the hot path
+    for (u32 i = 1; i < n; i++) {
+        u32 v = samples[i];
+        u32 j = i;
+        while (j > 0 && samples[j - 1] > v) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = v;
+    }
+
+    out->min = min;
+    out->max = max;
+    out->avg = (u32)(sum / n);
+    out->p99 = samples[(n * 99) / 100];
+    out->frames = n;
+    return 0;
+}
+
+int prof_dump(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        printf("Profiler dump failed: %s\n", path);
+        return -1;
+    }
+
+    fprintf(f, "frame");
+    for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+        fprintf(f, ",%s", phase_names[p]);
+    }
+    fprintf(f, "\n");
+
+    // Oldest first
+    u32 n = frames_recorded;
+    u32 start = (frames_recorded < PROF_RING_FRAMES) ? 0 : ring_frame;
+    for (u32 i = 0; i < n; i++) {
+        u32 idx = (start + i) % PROF_RING_FRAMES;
+        fprintf(f, "%u", i);
+        for (int p = 0; p < PROF_PHASE_COUNT; p++) {
+            fprintf(f, ",%u", ring[idx][p]);
+        }
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+    printf("Profiler: dumped %u frames to %s\n", n, path);
+    return 0;
+}
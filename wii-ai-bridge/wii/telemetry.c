@@ -0,0 +1,114 @@
+/*
+ * Telemetry aggregation and emit
+ *
+ * Aggregation is plain counter arrays touched from the frame loop
+ * only, so there is nothing to lock. The emit path reuses the AI
+ * socket (already non-blocking) with the collector's own address, so
+ * a slow or absent collector costs one dropped datagram and nothing
+ * else.
+ */
+
+#include <string.h>
+#include <gccore.h>
+#include <network.h>
+
+#include "telemetry.h"
+
+static u32 counters[TELEM_COUNTER_COUNT];
+static u32 gesture_counts[6];
+static u32 frame_hist[TELEMETRY_HIST_BUCKETS];
+static u32 frames_sampled = 0;
+static u32 emit_count = 0;
+
+static inline void store_u16(u8* p, u16 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)(v >> 8);
+}
+
+static inline void store_u32(u8* p, u32 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)((v >> 8) & 0xFF);
+    p[2] = (u8)((v >> 16) & 0xFF);
+    p[3] = (u8)((v >> 24) & 0xFF);
+}
+
+void telemetry_reset(void) {
+    memset(counters, 0, sizeof(counters));
+    memset(gesture_counts, 0, sizeof(gesture_counts));
+    memset(frame_hist, 0, sizeof(frame_hist));
+    frames_sampled = 0;
+    emit_count = 0;
+}
+
+void telemetry_count(TelemetryCounter counter) {
+    if (counter < TELEM_COUNTER_COUNT) {
+        counters[counter]++;
+    }
+}
+
+void telemetry_count_gesture(int gesture_type) {
+    if (gesture_type >= 0 && gesture_type < 6) {
+        gesture_counts[gesture_type]++;
+    }
+}
+
+void telemetry_frame_time(u32 frame_us) {
+    // log2 bucketing: one count-leading-zeros, no divides, no floats
+    int bucket = frame_us ? 31 - __builtin_clz(frame_us) : 0;
+    if (bucket >= TELEMETRY_HIST_BUCKETS) {
+        bucket = TELEMETRY_HIST_BUCKETS - 1;
+    }
+    frame_hist[bucket]++;
+    frames_sampled++;
+}
+
+/*
+ * Pack every aggregate into buf at the documented offsets
+ */
+static int pack_datagram(u8* buf, u32 frame, const AINetworkStats* net) {
+    u8* p = buf;
+
+    store_u16(p, TELEMETRY_MAGIC); p += 2;
+    *p++ = TELEMETRY_VERSION;
+    *p++ = 0;
+    store_u32(p, frame); p += 4;
+
+    // RTT as integer microseconds; zero until the first sample
+    store_u32(p, net->rtt_valid ? (u32)net->srtt_us : 0); p += 4;
+    store_u32(p, net->rtt_valid ? (u32)net->rttvar_us : 0); p += 4;
+
+    for (int i = 0; i < TELEM_COUNTER_COUNT; i++) {
+        store_u32(p, counters[i]); p += 4;
+    }
+    for (int i = 0; i < 6; i++) {
+        store_u32(p, gesture_counts[i]); p += 4;
+    }
+    store_u32(p, frames_sampled); p += 4;
+    for (int i = 0; i < TELEMETRY_HIST_BUCKETS; i++) {
+        store_u32(p, frame_hist[i]); p += 4;
+    }
+
+    return (int)(p - buf);
+}
+
+void telemetry_tick(u32 frame, s32 sock, const AINetworkStats* net) {
+    if (sock < 0 || frame == 0 || frame % TELEMETRY_EMIT_FRAMES != 0) {
+        return;
+    }
+
+    static u8 datagram[TELEMETRY_DATAGRAM_SIZE];
+    int len = pack_datagram(datagram, frame, net);
+
+    struct sockaddr_in collector;
+    collector.sin_family = AF_INET;
+    collector.sin_port = htons(TELEMETRY_COLLECTOR_PORT);
+    inet_aton(TELEMETRY_COLLECTOR_IP, &collector.sin_addr);
+
+    net_sendto(sock, datagram, len, 0,
+               (struct sockaddr*)&collector, sizeof(collector));
+    emit_count++;
+}
+
+u32 telemetry_emit_count(void) {
+    return emit_count;
+}
@@ -0,0 +1,164 @@
+/*
+ * Binary input trace recorder implementation
+ *
+ * Single producer (the input ingest path) and single consumer (the
+ * flush thread). The producer owns the active buffer and only hands a
+ * buffer to the consumer once it is full; the consumer signals it back
+ * empty through a volatile index. No locks needed, same SPSC pattern
+ * as the input rings.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <gccore.h>
+
+#include "trace_recorder.h"
+
+// Wire stores are explicit little-endian bytes: traces recorded on
+// the (big-endian) Gekko replay unchanged on x86 hosts
+static inline void store_u16(u8* p, u16 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)(v >> 8);
+}
+
+static inline void store_u32(u8* p, u32 v) {
+    p[0] = (u8)(v & 0xFF);
+    p[1] = (u8)((v >> 8) & 0xFF);
+    p[2] = (u8)((v >> 16) & 0xFF);
+    p[3] = (u8)((v >> 24) & 0xFF);
+}
+
+static inline void store_f32(u8* p, float v) {
+    u32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    store_u32(p, bits);
+}
+
+// Double buffer of encoded records
+static u8 buffers[2][TRACE_BUFFER_RECORDS * TRACE_RECORD_SIZE];
+static int active_buffer = 0;       // producer-owned
+static int fill_count = 0;          // records in the active buffer
+static volatile int pending = -1;   // buffer index handed to the flusher
+static volatile int pending_count = 0;
+
+static FILE* trace_file = NULL;
+static volatile bool recorder_running = false;
+static u32 dropped_records = 0;
+
+static lwp_t flush_thread = LWP_THREAD_NULL;
+static u8 flush_stack[16 * 1024] ATTRIBUTE_ALIGN(8);
+
+// How often the flusher checks for a full buffer. At 200 Hz sampling
+// a buffer holds ~2.5 s of one channel, so 10 ms is generous.
+#define TRACE_FLUSH_POLL_US 10000
+
+static void flush_pending(void) {
+    int idx = pending;
+    if (idx < 0) return;
+
+    fwrite(buffers[idx], TRACE_RECORD_SIZE, (size_t)pending_count, trace_file);
+    pending = -1;  // hand the buffer back to the producer
+}
+
+static void* flusher_main(void* arg) {
+    (void)arg;
+
+    while (recorder_running) {
+        flush_pending();
+        usleep(TRACE_FLUSH_POLL_US);
+    }
+
+    // Final pass for whatever was handed over during shutdown
+    flush_pending();
+    return NULL;
+}
+
+int trace_recorder_start(const char* path) {
+    if (recorder_running) return 0;
+
+    trace_file = fopen(path, "wb");
+    if (!trace_file) {
+        printf("Trace recorder: cannot open %s\n", path);
+        return -1;
+    }
+
+    active_buffer = 0;
+    fill_count = 0;
+    pending = -1;
+    dropped_records = 0;
+    recorder_running = true;
+
+    if (LWP_CreateThread(&flush_thread, flusher_main, NULL,
+                         flush_stack, sizeof(flush_stack), 60) < 0) {
+        recorder_running = false;
+        fclose(trace_file);
+        trace_file = NULL;
+        printf("Trace recorder: flush thread creation failed\n");
+        return -1;
+    }
+
+    printf("Trace recorder: logging to %s\n", path);
+    return 0;
+}
+
+void trace_recorder_stop(void) {
+    if (!recorder_running) return;
+
+    // Hand over the partially filled buffer, then wait out the flusher
+    while (pending >= 0) {
+        usleep(TRACE_FLUSH_POLL_US);
+    }
+    pending_count = fill_count;
+    pending = active_buffer;
+    fill_count = 0;
+
+    recorder_running = false;
+    LWP_JoinThread(flush_thread, NULL);
+    flush_thread = LWP_THREAD_NULL;
+
+    fclose(trace_file);
+    trace_file = NULL;
+
+    if (dropped_records > 0) {
+        printf("Trace recorder: dropped %u records (SD too slow)\n",
+               dropped_records);
+    }
+}
+
+bool trace_recorder_active(void) {
+    return recorder_running;
+}
+
+void trace_recorder_capture(int channel, const InputSnapshot* snap) {
+    if (!recorder_running) return;
+
+    if (fill_count >= TRACE_BUFFER_RECORDS) {
+        if (pending >= 0) {
+            // Flusher still owns the other buffer: drop, never stall
+            dropped_records++;
+            return;
+        }
+        pending_count = fill_count;
+        pending = active_buffer;
+        active_buffer ^= 1;
+        fill_count = 0;
+    }
+
+    u8* rec = &buffers[active_buffer][fill_count * TRACE_RECORD_SIZE];
+    rec[0] = (u8)channel;
+    rec[1] = snap->gyro.valid ? 1 : 0;
+    store_u16(rec + 2, 0);
+    store_u32(rec + 4, snap->buttons_held);
+    store_f32(rec + 8, snap->accel.x);
+    store_f32(rec + 12, snap->accel.y);
+    store_f32(rec + 16, snap->accel.z);
+    store_f32(rec + 20, snap->gyro.pitch);
+    store_f32(rec + 24, snap->gyro.roll);
+    store_f32(rec + 28, snap->gyro.yaw);
+    fill_count++;
+}
+
+u32 trace_recorder_dropped(void) {
+    return dropped_records;
+}
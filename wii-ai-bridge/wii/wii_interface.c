@@ -19,13 +19,56 @@
 #include "ai_bridge.h"
 #include "game_state.h"
 #include "wii_interface.h"
+#include "ai_protocol.h"
+#include "gesture_simd.h"
+#include "input_history.h"
+#include "input_thread.h"
+#include "mem2_arena.h"
+#include "profiler.h"
+#include "trace_recorder.h"
+#include "ai_scheduler.h"
+#include "profile_store.h"
+#include "gesture_dtw.h"
+#include "ai_control.h"
+#include "telemetry.h"
 
-// Constants
-#define MAX_PLAYERS 4
+// Constants (shared limits live in wii_interface.h)
 #define AI_UPDATE_INTERVAL 16  // 60 FPS
-#define GESTURE_BUFFER_SIZE 32
 #define NETWORK_BUFFER_SIZE 1024
 
+// Frames to wait for an AI reply before falling back to local
+// processing while no RTT estimate exists yet; once replies flow, the
+// deadline adapts to the measured round trip (see rtt_deadline_frames)
+#define AI_RESPONSE_DEADLINE_FRAMES 8
+#define AI_DEADLINE_MIN_FRAMES 2
+#define AI_DEADLINE_MAX_FRAMES 16
+
+// RTT estimator gains, TCP-style (RFC 6298 shape): srtt chases the
+// sample at 1/8, rttvar chases the deviation at 1/4
+#define RTT_ALPHA 0.125f
+#define RTT_BETA 0.25f
+
+// A batched AI request that has been sent but not yet answered. The
+// original batch is kept so the local fallback can still run on
+// deadline, and the encoded frame stays in tx_frame_buffer so the
+// halfway-point retransmit resends the same bytes under the same
+// sequence. Points into one of two batch slots: while one batch is in
+// flight, the next one is staged player-by-player in the other.
+typedef struct {
+    bool in_flight;
+    bool retransmitted;
+    u32 sequence;
+    u32 sent_frame;
+    u64 sent_time;
+    int frame_len;
+    AIBatchRequest* batch;
+} PendingAIBatch;
+
+// Frames between a player's slot and the next player's: slice
+// assembly for four players is spread across the AI interval instead
+// of stacking on one frame
+#define AI_PLAYER_SLOT_STRIDE (AI_UPDATE_INTERVAL / MAX_PLAYERS)
+
 // Global variables
 static bool ai_bridge_initialized = false;
 static WiiPlayer players[MAX_PLAYERS];
@@ -33,9 +76,181 @@ static GameState current_game_state;
 static GestureBuffer gesture_buffers[MAX_PLAYERS];
 static u32 frame_counter = 0;
 
+// Per-player, per-frame gesture analysis cache. Game code calls
+// wii_ai_get_enhanced_input() from several subsystems in one frame;
+// the first caller computes, the rest read the cached result.
+typedef struct {
+    u32 frame;
+    bool valid;
+    GestureAnalysis analysis;
+} GestureCache;
+static GestureCache gesture_cache[MAX_PLAYERS];
+
+// Per-player AI response cache. Players sit in the same gesture state
+// for long stretches (menus, idle), and the server's answer for the
+// same quantized situation is the same answer — so on a key match the
+// previous AIResponse is replayed locally and the player is left out
+// of the network batch entirely.
+typedef struct {
+    u8 gesture_type;
+    u8 intensity_bucket;    // intensity in 0.25 steps, capped
+    u8 game_type;
+    u8 difficulty_bucket;   // difficulty in 0.125 steps
+} ResponseKey;
+
+typedef struct {
+    bool valid;
+    ResponseKey key;
+    AIResponse response;
+} ResponseCache;
+static ResponseCache response_cache[MAX_PLAYERS];
+static ResponseKey in_flight_keys[MAX_PLAYERS];
+static u32 response_cache_hits = 0;
+
 // Network communication
 static s32 network_socket = -1;
-static char network_buffer[NETWORK_BUFFER_SIZE];
+static u32 ai_request_sequence = 0;
+
+// Continuous RTT estimation over the request/reply exchange. Feeds
+// the async pipeline's deadline and surfaces per-cabinet network
+// health through wii_ai_get_network_stats().
+static bool rtt_seeded = false;
+static float srtt_us = 0.0f;
+static float rttvar_us = 0.0f;
+static u32 retransmit_count = 0;
+static u32 stale_reply_count = 0;
+
+// Async bring-up: FAT mounting and net_init (DHCP) can each block for
+// seconds, so they run on their own lwp threads while the frame loop
+// starts immediately. The loop latches features on as each subsystem
+// flips to READY; everything downstream already degrades gracefully
+// while the socket is -1 and no profiles are loaded.
+static volatile BridgeSubsysState fat_state = BRIDGE_SUBSYS_PENDING;
+static volatile BridgeSubsysState net_state = BRIDGE_SUBSYS_PENDING;
+static bool fat_latched = false;
+static lwp_t fat_thread = LWP_THREAD_NULL;
+static lwp_t net_thread = LWP_THREAD_NULL;
+static u8 fat_stack[16 * 1024] ATTRIBUTE_ALIGN(8);
+static u8 net_stack[16 * 1024] ATTRIBUTE_ALIGN(8);
+
+// GameState delta tracking: mutators flag what they touched, the wire
+// layer sends only flagged fields between keyframes. A periodic full
+// keyframe bounds how stale a server that missed deltas can get.
+#define AI_KEYFRAME_INTERVAL 30  // batches (~8 s at one batch / 16 frames)
+static u8 game_state_dirty = GS_DIRTY_ALL;
+static u32 batches_until_keyframe = 0;
+
+// Predictive local AI layer: the local model pulls each player's
+// assistance level toward its own target every frame, so tuning stays
+// fresh across the server round trip. Server replies still land
+// authoritatively in apply_ai_response(); prediction resumes from the
+// corrected value. The blend factor hides 1-2 frames of latency
+// without letting local and server estimates fight visibly.
+#define PREDICTION_BLEND 0.15f
+// How far the newest motion delta leads the window mean when
+// extrapolating the gesture a few samples ahead
+#define PREDICTION_LEAD 0.75f
+static GestureAnalysis predicted_gestures[MAX_PLAYERS];
+
+// A single delta this far past the swing cut reads as a swing even
+// when the window mean hasn't caught up yet: short sharp swings leave
+// most of the window quiet, so the mean alone classifies them late
+#define GESTURE_PEAK_SWING_FACTOR 2.0f
+
+// AI path slots, carved out of the MEM2 arena at init so the hot path
+// never allocates. The static fallbacks keep the bridge functional if
+// the arena is unavailable.
+static PendingAIBatch pending_batch_fallback = {
+    .batch = NULL  // pointed at a batch slot during init
+};
+static AIBatchRequest batch_slots_fallback[2];
+static u8 network_buffer_fallback[NETWORK_BUFFER_SIZE];
+static u8 tx_buffer_fallback[AI_PROTO_MAX_BATCH_REQUEST_SIZE];
+static AIResponse response_slots_fallback[MAX_PLAYERS];
+static PendingAIBatch* pending_batch = &pending_batch_fallback;
+static AIBatchRequest* staging_batch = &batch_slots_fallback[0];
+static u8* network_buffer = network_buffer_fallback;
+static u8* tx_frame_buffer = tx_buffer_fallback;
+// Per-player pinned response slots: replies decode straight into the
+// owning player's slot and flow onward by pointer, never by copy
+static AIResponse* response_slots = response_slots_fallback;
+
+// Per-game-type update pipeline, installed by wii_ai_set_game_type().
+// The per-frame branching on game type collapses into one table read:
+// classification thresholds, AI cadence and the game-job mix are all
+// properties of the installed pipeline, so a sports title runs a
+// swing-tuned path with no adventure plumbing and menus run a
+// near-no-op frame.
+typedef struct {
+    float swing_threshold;     // gesture classification cut points
+    float point_threshold;
+    u32 game_ai_interval;      // frames between game-AI job refills
+    bool run_ai_pipeline;      // prediction + batched server round trip
+    void (*queue_game_jobs)(void);  // NULL: no game-side AI at all
+} AIPipeline;
+
+static void queue_core_game_jobs(void);
+static void queue_adventure_game_jobs(void);
+
+static const AIPipeline pipelines[] = {
+    // GAME_TYPE_MENU: nothing to adapt to on a menu screen
+    [GAME_TYPE_MENU]      = { 0.80f, 0.30f,  0, false, NULL },
+    // Swing-heavy: earlier swing cut so fast strokes register sooner
+    [GAME_TYPE_SPORTS]    = { 0.60f, 0.30f, 16, true,  queue_core_game_jobs },
+    [GAME_TYPE_ADVENTURE] = { 0.80f, 0.30f, 16, true,  queue_adventure_game_jobs },
+    [GAME_TYPE_PARTY]     = { 0.70f, 0.30f, 16, true,  queue_core_game_jobs },
+    // Sustained motion reads lower per-sample deltas than one swing
+    [GAME_TYPE_FITNESS]   = { 0.60f, 0.25f, 32, true,  queue_core_game_jobs },
+    // Tilt-steered: large accel deltas are noise, not gestures
+    [GAME_TYPE_RACING]    = { 0.85f, 0.40f, 32, true,  queue_core_game_jobs },
+    [GAME_TYPE_FIGHTING]  = { 0.75f, 0.35f, 16, true,  queue_core_game_jobs },
+};
+
+static const AIPipeline* active_pipeline = &pipelines[GAME_TYPE_MENU];
+
+// Init internals
+static int init_network(void);
+static void* fat_bringup_main(void* arg);
+static void* net_bringup_main(void* arg);
+static void latch_init_subsystems(void);
+static void init_player(WiiPlayer* player, int player_id);
+static void init_gesture_buffer(GestureBuffer* buffer);
+static void init_game_state(GameState* state);
+
+// Input path internals
+static void ingest_input_snapshot(WiiPlayer* player, int channel,
+                                  const InputSnapshot* snapshot);
+static void update_player_input(WiiPlayer* player, int channel);
+static void update_gesture_buffer(GestureBuffer* buffer,
+                                  const InputSnapshot* input);
+static void update_timing_stats(InputTimingStats* stats, u64 timestamp);
+static GestureAnalysis analyze_gesture_pattern(GestureBuffer* buffer);
+static GestureAnalysis get_gesture_analysis(int player_id);
+static void update_skill_estimation(WiiPlayer* player, GestureAnalysis* gesture);
+
+// Game AI internals
+static float calculate_input_consistency(AIRequest* request);
+
+// Async pipeline internals
+static void poll_ai_responses(void);
+static void expire_pending_requests(void);
+static void update_rtt_estimate(u32 rtt_us);
+static u32 rtt_deadline_frames(void);
+static int send_tx_frame(int frame_len);
+static void process_ai_updates(void);
+static void stage_player_slice(int channel);
+static void queue_ai_batch(AIBatchRequest* batch);
+static void run_batch_locally(const AIBatchRequest* batch);
+static void slice_to_request(const AIBatchRequest* batch,
+                             const AIPlayerSlice* slice, AIRequest* request);
+static int process_ai_locally(AIRequest* request, AIResponse* response);
+static void apply_ai_response(WiiPlayer* player, AIResponse* response);
+static ResponseKey make_response_key(const GestureAnalysis* gesture);
+static bool response_key_equal(const ResponseKey* a, const ResponseKey* b);
+
+// Predictive local layer internals
+static GestureAnalysis predict_gesture(int player_id);
+static void update_local_predictions(void);
 
 /*
  * Initialize the Wii AI Bridge system
@@ -49,27 +264,71 @@ int wii_ai_bridge_init(void) {
     // Initialize Wii Remote system
     WPAD_Init();
     WPAD_SetDataFormat(WPAD_CHAN_ALL, WPAD_FMT_BTNS_ACC_IR);
-    
-    // Initialize FAT filesystem
-    if (!fatInitDefault()) {
-        printf("Error: Could not initialize FAT filesystem\n");
-        return -1;
+
+    // FAT and network bring-up each block for seconds; hand them to
+    // background threads so the first frame renders immediately
+    if (LWP_CreateThread(&fat_thread, fat_bringup_main, NULL,
+                         fat_stack, sizeof(fat_stack), 60) < 0) {
+        fat_state = fatInitDefault() ? BRIDGE_SUBSYS_READY
+                                     : BRIDGE_SUBSYS_FAILED;
     }
-    
-    // Initialize network for AI communication
-    if (init_network() < 0) {
-        printf("Warning: Network initialization failed, AI features limited\n");
+    if (LWP_CreateThread(&net_thread, net_bringup_main, NULL,
+                         net_stack, sizeof(net_stack), 60) < 0) {
+        net_state = (init_network() == 0) ? BRIDGE_SUBSYS_READY
+                                          : BRIDGE_SUBSYS_FAILED;
     }
-    
-    // Initialize player data
+
+    // Carve the AI path's long-lived slots out of MEM2, cache-line
+    // aligned; on failure the static fallbacks stay in place
+    if (mem2_arena_init() == 0) {
+        PendingAIBatch* batch_slot =
+            mem2_arena_alloc(sizeof(PendingAIBatch), MEM2_CACHE_LINE);
+        AIBatchRequest* stage_a =
+            mem2_arena_alloc(sizeof(AIBatchRequest), MEM2_CACHE_LINE);
+        AIBatchRequest* stage_b =
+            mem2_arena_alloc(sizeof(AIBatchRequest), MEM2_CACHE_LINE);
+        u8* rx_slot = mem2_arena_alloc(NETWORK_BUFFER_SIZE, MEM2_CACHE_LINE);
+        u8* tx_slot = mem2_arena_alloc(AI_PROTO_MAX_BATCH_REQUEST_SIZE,
+                                       MEM2_CACHE_LINE);
+        AIResponse* resp_slots =
+            mem2_arena_alloc(MAX_PLAYERS * sizeof(AIResponse),
+                             MEM2_CACHE_LINE);
+        if (batch_slot && stage_a && stage_b && rx_slot && tx_slot &&
+            resp_slots) {
+            memset(batch_slot, 0, sizeof(PendingAIBatch));
+            memset(stage_a, 0, sizeof(AIBatchRequest));
+            memset(stage_b, 0, sizeof(AIBatchRequest));
+            memset(resp_slots, 0, MAX_PLAYERS * sizeof(AIResponse));
+            pending_batch = batch_slot;
+            staging_batch = stage_a;
+            pending_batch->batch = stage_b;
+            network_buffer = rx_slot;
+            tx_frame_buffer = tx_slot;
+            response_slots = resp_slots;
+        }
+    }
+    if (pending_batch->batch == NULL) {
+        pending_batch->batch = &batch_slots_fallback[1];
+    }
+    ai_scheduler_reset();
+    telemetry_reset();
+
+    // Initialize player data; saved profiles are restored by
+    // latch_init_subsystems() once the FAT mount reports ready
     for (int i = 0; i < MAX_PLAYERS; i++) {
         init_player(&players[i], i);
         init_gesture_buffer(&gesture_buffers[i]);
     }
-    
+
     // Initialize game state
     init_game_state(&current_game_state);
-    
+
+    // Start the dedicated input sampler; on failure the main loop
+    // falls back to sampling inline at frame rate
+    if (input_thread_start() < 0) {
+        printf("Warning: inline input sampling (frame-rate locked)\n");
+    }
+
     ai_bridge_initialized = true;
     printf("Wii AI Bridge initialized successfully!\n");
     return 0;
@@ -85,18 +344,76 @@ static int init_network(void) {
         printf("Network init failed: %d\n", result);
         return -1;
     }
-    
+
     // Create socket for AI communication
-    network_socket = net_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (network_socket < 0) {
-        printf("Socket creation failed: %d\n", network_socket);
+    s32 sock = net_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        printf("Socket creation failed: %d\n", sock);
         return -1;
     }
-    
+
+    // Non-blocking: the frame loop must never wait on the network
+    u32 flags = net_fcntl(sock, F_GETFL, 0);
+    if (net_fcntl(sock, F_SETFL, flags | IOS_O_NONBLOCK) < 0) {
+        printf("Warning: could not set socket non-blocking\n");
+    }
+
+    // Publish the socket only once fully configured; the frame loop
+    // may already be running and keys off network_socket >= 0
+    network_socket = sock;
     printf("Network initialized for AI communication\n");
     return 0;
 }
 
+/*
+ * Background bring-up threads. Each does its one blocking call and
+ * reports through the state flag; the frame loop never waits on them.
+ */
+static void* fat_bringup_main(void* arg) {
+    (void)arg;
+    fat_state = fatInitDefault() ? BRIDGE_SUBSYS_READY
+                                 : BRIDGE_SUBSYS_FAILED;
+    return NULL;
+}
+
+static void* net_bringup_main(void* arg) {
+    (void)arg;
+    net_state = (init_network() == 0) ? BRIDGE_SUBSYS_READY
+                                      : BRIDGE_SUBSYS_FAILED;
+    return NULL;
+}
+
+/*
+ * Latch AI features on as subsystems come up. Runs on the frame loop
+ * so all player-state mutation stays on one thread: once FAT reports
+ * ready, saved profiles are restored and checkpointing starts. The
+ * network path needs no latch step — it keys off network_socket.
+ */
+static void latch_init_subsystems(void) {
+    if (fat_latched || fat_state == BRIDGE_SUBSYS_PENDING) return;
+    fat_latched = true;
+
+    if (fat_state == BRIDGE_SUBSYS_FAILED) {
+        printf("Warning: FAT mount failed, profiles disabled\n");
+        return;
+    }
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        profile_store_load(i, &players[i]);
+    }
+    if (profile_store_start() < 0) {
+        printf("Warning: profiles will not be checkpointed\n");
+    }
+    gesture_dtw_load(NULL);  // builtins stand if the blob is absent
+}
+
+BridgeSubsysState wii_ai_bridge_fat_state(void) {
+    return fat_state;
+}
+
+BridgeSubsysState wii_ai_bridge_net_state(void) {
+    return net_state;
+}
+
 /*
  * Initialize player data structure
  */
@@ -109,7 +426,11 @@ static void init_player(WiiPlayer* player, int player_id) {
     // Initialize input history
     memset(&player->input_history, 0, sizeof(InputHistory));
     player->input_history.write_index = 0;
-    
+
+    // Streaming timing estimator re-seeds on the first input
+    memset(&player->timing, 0, sizeof(InputTimingStats));
+
+
     // Initialize AI profile
     player->ai_profile.learning_rate = 0.1f;
     player->ai_profile.adaptation_speed = 0.05f;
@@ -125,6 +446,13 @@ static void init_gesture_buffer(GestureBuffer* buffer) {
     buffer->write_index = 0;
     buffer->sample_count = 0;
     memset(buffer->samples, 0, sizeof(buffer->samples));
+
+    // Reset incremental motion statistics
+    memset(buffer->delta_magnitudes, 0, sizeof(buffer->delta_magnitudes));
+    buffer->delta_count = 0;
+    buffer->motion_sum = 0.0f;
+    buffer->motion_sq_sum = 0.0f;
+    buffer->motion_peak = 0.0f;
 }
 
 /*
@@ -150,264 +478,759 @@ void wii_ai_bridge_update(void) {
     
     frame_counter++;
     current_game_state.frame_count = frame_counter;
-    
-    // Scan for Wii Remote input
-    WPAD_ScanPads();
-    
-    // Update each connected player
-    for (int i = 0; i < MAX_PLAYERS; i++) {
-        if (WPAD_Probe(i, NULL) == WPAD_ERR_NONE) {
-            players[i].connected = true;
-            update_player_input(&players[i], i);
-            
-            // Process AI enhancements every few frames
-            if (frame_counter % AI_UPDATE_INTERVAL == 0) {
-                process_ai_for_player(&players[i], i);
+
+    // Pick up any background bring-up that finished since last frame
+    latch_init_subsystems();
+
+    u64 frame_start = gettime();
+    prof_frame_begin();
+
+    // Drain any AI responses that arrived since last frame
+    prof_phase_begin(PROF_PHASE_NET_POLL);
+    poll_ai_responses();
+    prof_phase_end(PROF_PHASE_NET_POLL);
+
+    // Update each connected player. With the sampling thread running,
+    // input arrives through the per-player rings at a fixed high rate;
+    // otherwise sample inline at frame rate as before.
+    prof_phase_begin(PROF_PHASE_INPUT);
+    if (input_thread_running()) {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            players[i].connected = input_thread_probe(i);
+            if (!players[i].connected) continue;
+
+            InputSnapshot snapshot;
+            while (input_ring_pop(i, &snapshot)) {
+                ingest_input_snapshot(&players[i], i, &snapshot);
+            }
+        }
+    } else {
+        WPAD_ScanPads();
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            if (WPAD_Probe(i, NULL) == WPAD_ERR_NONE) {
+                players[i].connected = true;
+                update_player_input(&players[i], i);
+            } else {
+                players[i].connected = false;
             }
-        } else {
-            players[i].connected = false;
         }
     }
-    
-    // Update game state with AI
-    if (frame_counter % AI_UPDATE_INTERVAL == 0) {
-        update_game_ai();
+    prof_phase_end(PROF_PHASE_INPUT);
+
+    // Local prediction runs every frame; the batched server round
+    // trip (staged player-by-player inside process_ai_updates) only
+    // corrects it once per AI interval. Pipelines that don't adapt
+    // (menus) skip the whole block.
+    prof_phase_begin(PROF_PHASE_AI);
+    if (active_pipeline->run_ai_pipeline) {
+        update_local_predictions();
+        process_ai_updates();
+
+        // Requests past their deadline fall back to local processing
+        expire_pending_requests();
+    }
+    prof_phase_end(PROF_PHASE_AI);
+
+    // Game-side AI work: the installed pipeline queues its own job
+    // mix at its own cadence; the scheduler drains a little every
+    // frame under budget
+    prof_phase_begin(PROF_PHASE_GAME_AI);
+    if (active_pipeline->queue_game_jobs &&
+        frame_counter % active_pipeline->game_ai_interval == 0) {
+        active_pipeline->queue_game_jobs();
+    }
+    ai_scheduler_drain();
+    prof_phase_end(PROF_PHASE_GAME_AI);
+
+    profile_store_tick(frame_counter, players);
+
+    prof_frame_end();
+
+    // Telemetry aggregation (integer-only) and the per-second emit
+    telemetry_frame_time(diff_usec(frame_start, gettime()));
+    AINetworkStats net_stats = wii_ai_get_network_stats();
+    telemetry_tick(frame_counter, network_socket, &net_stats);
+}
+
+/*
+ * Poll the socket for AI responses and apply them. Non-blocking: loops
+ * only while complete datagrams are already queued in the stack.
+ */
+static void poll_ai_responses(void) {
+    if (network_socket < 0) return;
+
+    for (;;) {
+        int received = net_recvfrom(network_socket, network_buffer,
+                                    NETWORK_BUFFER_SIZE, 0, NULL, NULL);
+        if (received <= 0) {
+            break;  // nothing queued (or transient error): try next frame
+        }
+
+        int response_count = 0;
+        u32 sequence = 0;
+        if (ai_protocol_validate_batch_response(network_buffer, received,
+                                                &response_count,
+                                                &sequence) != 0) {
+            printf("Dropped malformed AI response\n");
+            continue;
+        }
+
+        if (!pending_batch->in_flight || pending_batch->sequence != sequence) {
+            // Stale reply from a superseded batch: dropping it here is
+            // itself a win — no apply cost is paid for dead data
+            stale_reply_count++;
+            telemetry_count(TELEM_STALE_REPLIES);
+            continue;
+        }
+
+        // A matching reply is an RTT sample. Retransmitted exchanges
+        // are skipped (Karn's rule): the sample could be against
+        // either transmission.
+        if (!pending_batch->retransmitted) {
+            update_rtt_estimate(diff_usec(pending_batch->sent_time,
+                                          gettime()));
+        }
+        telemetry_count(TELEM_ROUND_TRIPS);
+
+        // Fan the batch out: each slice decodes in place from the rx
+        // buffer straight into the owning player's pinned slot, and
+        // the slot pointer flows onward — no intermediate batch copy
+        for (int i = 0; i < response_count; i++) {
+            const u8* slice =
+                ai_protocol_batch_response_slice(network_buffer, i);
+            int player_id = ai_protocol_response_slice_player(slice);
+            if (player_id < 0 || player_id >= MAX_PLAYERS) {
+                continue;
+            }
+            AIResponse* response = &response_slots[player_id];
+            ai_protocol_decode_response_payload(slice, response);
+            apply_ai_response(&players[player_id], response);
+
+            // Remember the server's answer for this quantized situation
+            ResponseCache* cached = &response_cache[player_id];
+            cached->key = in_flight_keys[player_id];
+            memcpy(&cached->response, response, sizeof(AIResponse));
+            cached->valid = true;
+        }
+        pending_batch->in_flight = false;
     }
 }
 
 /*
- * Update player input and store in history
+ * Fold one RTT sample into the smoothed estimate
+ */
+static void update_rtt_estimate(u32 rtt_us) {
+    float sample = (float)rtt_us;
+    if (!rtt_seeded) {
+        srtt_us = sample;
+        rttvar_us = sample / 2.0f;
+        rtt_seeded = true;
+        return;
+    }
+    float dev = sample - srtt_us;
+    if (dev < 0.0f) dev = -dev;
+    rttvar_us += (dev - rttvar_us) * RTT_BETA;
+    srtt_us += (sample - srtt_us) * RTT_ALPHA;
+}
+
+/*
+ * Reply deadline in frames, adapted to the measured round trip:
+ * srtt + 4*rttvar, as frames at 60 Hz, clamped. Falls back to the
+ * static default until the first sample arrives.
+ */
+static u32 rtt_deadline_frames(void) {
+    if (!rtt_seeded) return AI_RESPONSE_DEADLINE_FRAMES;
+
+    u32 frames = (u32)((srtt_us + 4.0f * rttvar_us) / 16667.0f) + 1;
+    if (frames < AI_DEADLINE_MIN_FRAMES) frames = AI_DEADLINE_MIN_FRAMES;
+    if (frames > AI_DEADLINE_MAX_FRAMES) frames = AI_DEADLINE_MAX_FRAMES;
+    return frames;
+}
+
+/*
+ * Send the currently encoded frame in tx_frame_buffer to the AI
+ * engine; shared by the first transmission and the retransmit path
+ */
+static int send_tx_frame(int frame_len) {
+    struct sockaddr_in ai_server;
+    ai_server.sin_family = AF_INET;
+    ai_server.sin_port = htons(AI_ENGINE_PORT);
+    inet_aton("192.168.1.100", &ai_server.sin_addr);  // AI engine IP
+
+    return net_sendto(network_socket, tx_frame_buffer, frame_len, 0,
+                      (struct sockaddr*)&ai_server, sizeof(ai_server));
+}
+
+/*
+ * Deadline handling for the in-flight batch: halfway to the deadline
+ * the latest request is retransmitted once (same bytes, same
+ * sequence — only the newest batch is ever worth recovering); at the
+ * deadline the local fallback runs
+ */
+static void expire_pending_requests(void) {
+    if (!pending_batch->in_flight) return;
+
+    u32 deadline = rtt_deadline_frames();
+    u32 elapsed = frame_counter - pending_batch->sent_frame;
+
+    if (elapsed >= deadline) {
+        run_batch_locally(pending_batch->batch);  // in-place, no copy
+        pending_batch->in_flight = false;
+        telemetry_count(TELEM_LOCAL_FALLBACKS);
+    } else if (elapsed >= deadline / 2 && !pending_batch->retransmitted &&
+               pending_batch->frame_len > 0 && network_socket >= 0) {
+        send_tx_frame(pending_batch->frame_len);
+        pending_batch->retransmitted = true;
+        retransmit_count++;
+        telemetry_count(TELEM_RETRANSMITS);
+    }
+}
+
+/*
+ * Ingest one input snapshot into history and the gesture buffer.
+ * Snapshots come either from the sampling thread's rings or from the
+ * inline frame-rate fallback.
+ */
+static void ingest_input_snapshot(WiiPlayer* player, int channel,
+                                  const InputSnapshot* snapshot) {
+    // Fold the inter-input gap into the streaming timing estimator
+    update_timing_stats(&player->timing, snapshot->timestamp);
+
+    // Scatter the snapshot into the per-field history streams
+    input_history_push(&player->input_history, snapshot);
+
+    // Update gesture buffer
+    update_gesture_buffer(&gesture_buffers[channel], snapshot);
+
+    // Log raw motion when a trace is being recorded (no I/O here;
+    // the recorder's flush thread does the SD writes)
+    trace_recorder_capture(channel, snapshot);
+}
+
+/*
+ * Inline sampling fallback: capture WPAD data directly on the main
+ * loop when the sampling thread is unavailable
  */
 static void update_player_input(WiiPlayer* player, int channel) {
     WPADData* data = WPAD_Data(channel);
     if (!data) return;
-    
-    // Get current input snapshot
-    InputSnapshot* current = &player->input_history.snapshots[player->input_history.write_index];
-    
+
+    InputSnapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+
     // Store button data
-    current->buttons_held = data->btns_h;
-    current->buttons_pressed = data->btns_d;
-    current->buttons_released = data->btns_u;
-    
+    snapshot.buttons_held = data->btns_h;
+    snapshot.buttons_pressed = data->btns_d;
+    snapshot.buttons_released = data->btns_u;
+
     // Store accelerometer data
-    current->accel.x = data->accel.x;
-    current->accel.y = data->accel.y;
-    current->accel.z = data->accel.z;
-    
+    snapshot.accel.x = data->accel.x;
+    snapshot.accel.y = data->accel.y;
+    snapshot.accel.z = data->accel.z;
+
     // Store IR pointer data
     if (data->ir.valid) {
-        current->ir.valid = true;
-        current->ir.x = data->ir.x;
-        current->ir.y = data->ir.y;
-        current->ir.angle = data->ir.angle;
+        snapshot.ir.valid = true;
+        snapshot.ir.x = data->ir.x;
+        snapshot.ir.y = data->ir.y;
+        snapshot.ir.angle = data->ir.angle;
     } else {
-        current->ir.valid = false;
+        snapshot.ir.valid = false;
     }
-    
+
     // Store gyroscope data (if available)
     if (data->exp.type == WPAD_EXP_MOTION_PLUS) {
-        current->gyro.pitch = data->exp.mp.pitch;
-        current->gyro.roll = data->exp.mp.roll;
-        current->gyro.yaw = data->exp.mp.yaw;
-        current->gyro.valid = true;
+        snapshot.gyro.pitch = data->exp.mp.pitch;
+        snapshot.gyro.roll = data->exp.mp.roll;
+        snapshot.gyro.yaw = data->exp.mp.yaw;
+        snapshot.gyro.valid = true;
     } else {
-        current->gyro.valid = false;
+        snapshot.gyro.valid = false;
     }
-    
-    // Update timestamp
-    current->timestamp = gettime();
-    
-    // Update gesture buffer
-    update_gesture_buffer(&gesture_buffers[channel], current);
-    
-    // Advance write index
-    player->input_history.write_index = (player->input_history.write_index + 1) % INPUT_HISTORY_SIZE;
-    if (player->input_history.count < INPUT_HISTORY_SIZE) {
-        player->input_history.count++;
+
+    snapshot.timestamp = gettime();
+
+    ingest_input_snapshot(player, channel, &snapshot);
+}
+
+// EWMA weight for the timing estimator: at 200 Hz sampling this gives
+// a horizon of a couple of seconds
+#define TIMING_EWMA_ALPHA 0.05f
+
+/*
+ * Streaming inter-input timing estimator: exponentially weighted
+ * mean and variance, one multiply-add per sample, no window rescans.
+ * Consistency is 1 minus the coefficient of variation — steady input
+ * cadence scores near 1 regardless of the absolute rate.
+ */
+static void update_timing_stats(InputTimingStats* stats, u64 timestamp) {
+    if (!stats->seeded) {
+        stats->seeded = true;
+        stats->last_timestamp = timestamp;
+        stats->consistency = 0.5f;  // neutral until data accumulates
+        return;
     }
+
+    float gap = (float)diff_usec(stats->last_timestamp, timestamp);
+    stats->last_timestamp = timestamp;
+    if (gap <= 0.0f) return;
+
+    if (stats->timing_mean_us == 0.0f) {
+        stats->timing_mean_us = gap;
+        return;
+    }
+
+    float d = gap - stats->timing_mean_us;
+    stats->timing_mean_us += TIMING_EWMA_ALPHA * d;
+    stats->timing_var_us2 += TIMING_EWMA_ALPHA * (d * d - stats->timing_var_us2);
+
+    float cv = sqrtf(stats->timing_var_us2) / stats->timing_mean_us;
+    stats->consistency = fmaxf(0.0f, fminf(1.0f, 1.0f - cv));
 }
 
 /*
- * Update gesture recognition buffer
+ * Recompute the peak delta magnitude after the old peak left the
+ * window. Only runs when the evicted delta was the peak, so the cost
+ * amortizes to near zero.
  */
-static void update_gesture_buffer(GestureBuffer* buffer, InputSnapshot* input) {
-    GestureSample* sample = &buffer->samples[buffer->write_index];
-    
+static void recompute_motion_peak(GestureBuffer* buffer) {
+    float peak = 0.0f;
+    for (int i = 0; i < GESTURE_BUFFER_SIZE; i++) {
+        if (buffer->delta_magnitudes[i] > peak) {
+            peak = buffer->delta_magnitudes[i];
+        }
+    }
+    buffer->motion_peak = peak;
+}
+
+/*
+ * Update gesture recognition buffer and its running motion statistics
+ */
+static void update_gesture_buffer(GestureBuffer* buffer,
+                                  const InputSnapshot* input) {
+    int w = buffer->write_index;
+    GestureSample* sample = &buffer->samples[w];
+
+    // Overwriting the oldest sample invalidates the delta that paired
+    // it with its successor: retire that delta from the running sums
+    if (buffer->sample_count == GESTURE_BUFFER_SIZE) {
+        int evict = (w + 1) % GESTURE_BUFFER_SIZE;
+        float old_m = buffer->delta_magnitudes[evict];
+        buffer->motion_sum -= old_m;
+        buffer->motion_sq_sum -= old_m * old_m;
+        buffer->delta_magnitudes[evict] = 0.0f;
+        buffer->delta_count--;
+        if (old_m >= buffer->motion_peak) {
+            recompute_motion_peak(buffer);
+        }
+    }
+
     // Store accelerometer data
     sample->accel_x = input->accel.x;
     sample->accel_y = input->accel.y;
     sample->accel_z = input->accel.z;
-    
+
     // Store gyroscope data if available
     if (input->gyro.valid) {
         sample->gyro_pitch = input->gyro.pitch;
         sample->gyro_roll = input->gyro.roll;
         sample->gyro_yaw = input->gyro.yaw;
     }
-    
+
     sample->timestamp = input->timestamp;
-    
+
+    // Fold the new inter-sample delta into the running statistics
+    if (buffer->sample_count > 0) {
+        GestureSample* prev =
+            &buffer->samples[(w - 1 + GESTURE_BUFFER_SIZE) % GESTURE_BUFFER_SIZE];
+        float m = gesture_delta_magnitude(prev, sample);
+
+        buffer->delta_magnitudes[w] = m;
+        buffer->motion_sum += m;
+        buffer->motion_sq_sum += m * m;
+        buffer->delta_count++;
+        if (m > buffer->motion_peak) {
+            buffer->motion_peak = m;
+        }
+    }
+
     // Advance buffer
-    buffer->write_index = (buffer->write_index + 1) % GESTURE_BUFFER_SIZE;
+    buffer->write_index = (w + 1) % GESTURE_BUFFER_SIZE;
     if (buffer->sample_count < GESTURE_BUFFER_SIZE) {
         buffer->sample_count++;
     }
 }
 
 /*
- * Process AI enhancements for a specific player
+ * Process AI enhancements for all connected players. One batch request
+ * carries every player's slice and a single shared game state copy, so
+ * an AI cycle costs one datagram instead of four round trips.
  */
-static void process_ai_for_player(WiiPlayer* player, int channel) {
-    if (!player->connected) return;
-    
-    // Analyze recent input patterns
-    GestureAnalysis gesture = analyze_gesture_pattern(&gesture_buffers[channel]);
-    
-    // Send data to AI engine for processing
-    AIRequest request;
-    prepare_ai_request(&request, player, &gesture, &current_game_state);
-    
-    // Get AI response
-    AIResponse response;
-    if (send_ai_request(&request, &response) == 0) {
-        apply_ai_response(player, &response);
+static void process_ai_updates(void) {
+    // Staggered assembly: each player's slice is analyzed and staged
+    // in its own frame slot, and the batch goes out on the interval's
+    // last slot. Four players never pay the assembly cost in the same
+    // frame, which was exactly the observed 16th-frame hitch.
+    int phase = (int)(frame_counter % AI_UPDATE_INTERVAL);
+
+    if (phase == 0) {
+        staging_batch->player_count = 0;
     }
-    
-    // Update player skill estimation
+
+    if (phase % AI_PLAYER_SLOT_STRIDE == 0) {
+        stage_player_slice(phase / AI_PLAYER_SLOT_STRIDE);
+    }
+
+    if (phase == AI_UPDATE_INTERVAL - 1 && staging_batch->player_count > 0) {
+        // Game state and timestamp are sampled at send time so the
+        // freshest values travel, however early a slice was staged
+        staging_batch->timestamp = gettime();
+        memcpy(&staging_batch->game_state, &current_game_state,
+               sizeof(GameState));
+
+        // The response is applied by poll_ai_responses() on a later frame
+        queue_ai_batch(staging_batch);
+    }
+}
+
+/*
+ * Analyze one player and stage their slice into the batch being
+ * assembled (runs in that player's frame slot)
+ */
+static void stage_player_slice(int channel) {
+    WiiPlayer* player = &players[channel];
+    if (!player->connected) return;
+
+    // Analyze recent input patterns (cached per frame)
+    GestureAnalysis gesture = get_gesture_analysis(channel);
+
+    // Skill keeps updating whether or not the response is cached
     update_skill_estimation(player, &gesture);
+
+    // Same quantized situation as a previous round trip: replay
+    // the cached response and keep this player off the wire
+    ResponseKey key = make_response_key(&gesture);
+    ResponseCache* cached = &response_cache[channel];
+    if (cached->valid && response_key_equal(&key, &cached->key)) {
+        apply_ai_response(player, &cached->response);
+        response_cache_hits++;
+        telemetry_count(TELEM_CACHE_HITS);
+        return;
+    }
+    in_flight_keys[channel] = key;
+
+    AIPlayerSlice* slice = &staging_batch->players[staging_batch->player_count++];
+    slice->player_id = player->id;
+    memcpy(&slice->gesture, &gesture, sizeof(GestureAnalysis));
+    memcpy(&slice->profile, &player->ai_profile, sizeof(AIProfile));
+
+    // Linearized view of the most recent inputs, newest first
+    slice->input_count = input_history_window(&player->input_history,
+                                              AI_REQUEST_MAX_INPUTS,
+                                              slice->recent_inputs);
 }
 
 /*
- * Analyze gesture patterns from buffer
+ * Quantize the inputs that determine an AI response into a cache key.
+ * Buckets are coarse on purpose: a response only goes stale when the
+ * situation changes enough that the server would answer differently.
+ */
+static ResponseKey make_response_key(const GestureAnalysis* gesture) {
+    ResponseKey key;
+    key.gesture_type = (u8)gesture->type;
+
+    float intensity = gesture->intensity * 4.0f;  // 0.25 steps
+    if (intensity > 15.0f) intensity = 15.0f;
+    key.intensity_bucket = (u8)intensity;
+
+    key.game_type = (u8)current_game_state.game_type;
+    key.difficulty_bucket = (u8)(current_game_state.difficulty * 8.0f);
+    return key;
+}
+
+static bool response_key_equal(const ResponseKey* a, const ResponseKey* b) {
+    return a->gesture_type == b->gesture_type &&
+           a->intensity_bucket == b->intensity_bucket &&
+           a->game_type == b->game_type &&
+           a->difficulty_bucket == b->difficulty_bucket;
+}
+
+/*
+ * Rebuild a single-player AIRequest from a batch slice for the local
+ * fallback path
+ */
+static void slice_to_request(const AIBatchRequest* batch,
+                             const AIPlayerSlice* slice, AIRequest* request) {
+    request->player_id = slice->player_id;
+    request->timestamp = batch->timestamp;
+    memcpy(&request->gesture, &slice->gesture, sizeof(GestureAnalysis));
+    request->input_count = slice->input_count;
+    memcpy(request->recent_inputs, slice->recent_inputs,
+           sizeof(request->recent_inputs));
+    memcpy(&request->game_state, &batch->game_state, sizeof(GameState));
+    memcpy(&request->player_profile, &slice->profile, sizeof(AIProfile));
+}
+
+/*
+ * Run every slice of a batch through the local AI fallback
+ */
+static void run_batch_locally(const AIBatchRequest* batch) {
+    for (int i = 0; i < batch->player_count; i++) {
+        const AIPlayerSlice* slice = &batch->players[i];
+        if (slice->player_id < 0 || slice->player_id >= MAX_PLAYERS) continue;
+
+        AIRequest request;
+        AIResponse* response = &response_slots[slice->player_id];
+        slice_to_request(batch, slice, &request);
+        if (process_ai_locally(&request, response) == 0) {
+            apply_ai_response(&players[slice->player_id], response);
+
+            // A fallback answer is as cacheable as a server one: while
+            // the situation stays in the same buckets, don't keep
+            // re-sending a request the server isn't answering
+            ResponseCache* cached = &response_cache[slice->player_id];
+            cached->key = in_flight_keys[slice->player_id];
+            memcpy(&cached->response, response, sizeof(AIResponse));
+            cached->valid = true;
+        }
+    }
+}
+
+/*
+ * Analyze gesture patterns from buffer.
+ *
+ * Pure O(1) read of the running statistics that
+ * update_gesture_buffer() maintains; no per-sample work happens here.
  */
 static GestureAnalysis analyze_gesture_pattern(GestureBuffer* buffer) {
     GestureAnalysis analysis;
     memset(&analysis, 0, sizeof(analysis));
-    
-    if (buffer->sample_count < 3) {
+
+    if (buffer->delta_count < 2) {
         analysis.confidence = 0.0f;
         return analysis;
     }
-    
-    // Calculate motion intensity
-    float total_motion = 0.0f;
-    for (int i = 1; i < buffer->sample_count; i++) {
-        int prev_idx = (buffer->write_index - i - 1 + GESTURE_BUFFER_SIZE) % GESTURE_BUFFER_SIZE;
-        int curr_idx = (buffer->write_index - i + GESTURE_BUFFER_SIZE) % GESTURE_BUFFER_SIZE;
-        
-        GestureSample* prev = &buffer->samples[prev_idx];
-        GestureSample* curr = &buffer->samples[curr_idx];
-        
-        float dx = curr->accel_x - prev->accel_x;
-        float dy = curr->accel_y - prev->accel_y;
-        float dz = curr->accel_z - prev->accel_z;
-        
-        total_motion += sqrtf(dx*dx + dy*dy + dz*dz);
+
+    analysis.intensity = buffer->motion_sum / buffer->delta_count;
+
+    // Steadiness of the window from the running variance, the same
+    // coefficient-of-variation shape as update_timing_stats(): a flat
+    // window is a trustworthy intensity read, a spiky one is not
+    float var = buffer->motion_sq_sum / buffer->delta_count -
+                analysis.intensity * analysis.intensity;
+    float steadiness = 1.0f;
+    if (var > 0.0f && analysis.intensity > 0.0f) {
+        steadiness =
+            fmaxf(0.0f, 1.0f - sqrtf(var) / analysis.intensity);
     }
-    
-    analysis.intensity = total_motion / (buffer->sample_count - 1);
-    
-    // Simple gesture classification
-    if (analysis.intensity > 0.8f) {
+
+    // Classification against the installed pipeline's cut points
+    if (analysis.intensity > active_pipeline->swing_threshold) {
+        analysis.type = GESTURE_SWING;
+        analysis.confidence = 0.6f + 0.2f * steadiness;
+    } else if (buffer->motion_peak >
+               GESTURE_PEAK_SWING_FACTOR * active_pipeline->swing_threshold) {
+        // Peak override: one unambiguous delta beats a diluted mean
         analysis.type = GESTURE_SWING;
-        analysis.confidence = 0.8f;
-    } else if (analysis.intensity > 0.3f) {
-        analysis.type = GESTURE_POINT;
         analysis.confidence = 0.6f;
+    } else if (analysis.intensity > active_pipeline->point_threshold) {
+        analysis.type = GESTURE_POINT;
+        analysis.confidence = 0.4f + 0.2f * steadiness;
     } else {
         analysis.type = GESTURE_IDLE;
         analysis.confidence = 0.9f;
     }
-    
+
+    // Above the point cut, let the template matcher refine the
+    // intensity call: an accepted DTW match is a real shape, not just
+    // "a lot of motion". Idle windows never pay for a match.
+    if (analysis.intensity > active_pipeline->point_threshold &&
+        buffer->delta_count >= 4) {
+        float window[DTW_MAX_TEMPLATE_LEN];
+        int span = buffer->delta_count;
+        if (span > DTW_MAX_TEMPLATE_LEN) span = DTW_MAX_TEMPLATE_LEN;
+
+        // Linearize the newest span of the delta ring, oldest first
+        int start = (buffer->write_index - span + GESTURE_BUFFER_SIZE) %
+                    GESTURE_BUFFER_SIZE;
+        for (int i = 0; i < span; i++) {
+            window[i] =
+                buffer->delta_magnitudes[(start + i) % GESTURE_BUFFER_SIZE];
+        }
+
+        float dtw_confidence = 0.0f;
+        int matched = gesture_dtw_match(window, span, &dtw_confidence);
+        if (matched >= 0) {
+            analysis.type = (GestureType)matched;
+            analysis.confidence = 0.5f + 0.5f * dtw_confidence;
+        }
+    }
+
     return analysis;
 }
 
 /*
- * Prepare AI request packet
+ * Memoized gesture analysis: computed at most once per player per
+ * frame, shared by the AI cycle and every enhanced-input caller
  */
-static void prepare_ai_request(AIRequest* request, WiiPlayer* player, 
-                              GestureAnalysis* gesture, GameState* game_state) {
-    request->player_id = player->id;
-    request->timestamp = gettime();
-    
-    // Copy gesture data
-    memcpy(&request->gesture, gesture, sizeof(GestureAnalysis));
-    
-    // Copy recent input history
-    request->input_count = min(player->input_history.count, 5);  // Last 5 inputs
-    for (int i = 0; i < request->input_count; i++) {
-        int idx = (player->input_history.write_index - i - 1 + INPUT_HISTORY_SIZE) % INPUT_HISTORY_SIZE;
-        memcpy(&request->recent_inputs[i], &player->input_history.snapshots[idx], sizeof(InputSnapshot));
+static GestureAnalysis get_gesture_analysis(int player_id) {
+    GestureCache* cache = &gesture_cache[player_id];
+
+    if (!cache->valid || cache->frame != frame_counter) {
+        cache->analysis = analyze_gesture_pattern(&gesture_buffers[player_id]);
+        cache->frame = frame_counter;
+        cache->valid = true;
+        telemetry_count_gesture(cache->analysis.type);
+    }
+    return cache->analysis;
+}
+
+/*
+ * Short-horizon gesture prediction: extrapolate the window mean
+ * toward the newest inter-sample delta and reclassify. When a swing
+ * is building, the newest deltas lead the mean by several samples,
+ * so the predicted type flips before the plain analysis does.
+ */
+static GestureAnalysis predict_gesture(int player_id) {
+    GestureBuffer* buffer = &gesture_buffers[player_id];
+    GestureAnalysis predicted = get_gesture_analysis(player_id);
+    if (buffer->delta_count < 2) {
+        return predicted;
+    }
+
+    int newest = (buffer->write_index - 1 + GESTURE_BUFFER_SIZE) %
+                 GESTURE_BUFFER_SIZE;
+    float latest = buffer->delta_magnitudes[newest];
+    float mean = buffer->motion_sum / buffer->delta_count;
+    float projected = mean + (latest - mean) * PREDICTION_LEAD;
+
+    predicted.intensity = projected;
+    if (projected > active_pipeline->swing_threshold) {
+        predicted.type = GESTURE_SWING;
+        predicted.confidence = 0.6f;
+    } else if (projected > active_pipeline->point_threshold) {
+        predicted.type = GESTURE_POINT;
+        predicted.confidence = 0.5f;
+    } else {
+        predicted.type = GESTURE_IDLE;
+        predicted.confidence = 0.7f;
+    }
+    return predicted;
+}
+
+/*
+ * Per-frame predictive layer: the same heuristics as the local
+ * fallback, applied as a smooth pull instead of a snap, so assistance
+ * tracks the player between (and during lost) server round trips
+ */
+static void update_local_predictions(void) {
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        WiiPlayer* player = &players[i];
+        if (!player->connected) continue;
+
+        predicted_gestures[i] = predict_gesture(i);
+
+        // Local sensitivity target, same policy as process_ai_locally
+        float target = 1.0f +
+            (0.5f - player->ai_profile.skill_level) * 0.2f;
+        player->ai_assistance_level +=
+            (target - player->ai_assistance_level) * PREDICTION_BLEND;
     }
-    
-    // Copy game state
-    memcpy(&request->game_state, game_state, sizeof(GameState));
-    
-    // Copy player profile
-    memcpy(&request->player_profile, &player->ai_profile, sizeof(AIProfile));
 }
 
 /*
- * Send AI request and receive response
+ * Queue a batched AI request: encode and send without blocking. The
+ * reply is matched back up in poll_ai_responses(); if none arrives
+ * before the deadline, expire_pending_requests() runs the local
+ * fallback for every slice.
  */
-static int send_ai_request(AIRequest* request, AIResponse* response) {
+static void queue_ai_batch(AIBatchRequest* batch) {
     if (network_socket < 0) {
-        // Fallback to local AI processing
-        return process_ai_locally(request, response);
+        // No network: process locally and apply this frame
+        run_batch_locally(batch);
+        return;
     }
-    
-    // Serialize request to JSON (simplified)
-    char json_buffer[2048];
-    serialize_ai_request(request, json_buffer, sizeof(json_buffer));
-    
-    // Send to AI engine
-    struct sockaddr_in ai_server;
-    ai_server.sin_family = AF_INET;
-    ai_server.sin_port = htons(8080);  // AI engine port
-    inet_aton("192.168.1.100", &ai_server.sin_addr);  // AI engine IP
-    
-    int sent = net_sendto(network_socket, json_buffer, strlen(json_buffer), 0,
-                         (struct sockaddr*)&ai_server, sizeof(ai_server));
-    
-    if (sent < 0) {
-        printf("Failed to send AI request: %d\n", sent);
-        return -1;
+
+    // Encode the batch as a binary frame (no text formatting pass)
+    // into the pooled MEM2 transmit buffer. Steady-state batches are
+    // deltas carrying only dirty GameState fields; a full keyframe
+    // goes out periodically so the server can resynchronize.
+    u32 sequence = ++ai_request_sequence;
+    int frame_len;
+    if (batches_until_keyframe == 0) {
+        frame_len = ai_protocol_encode_batch_request(batch, sequence,
+                                                     tx_frame_buffer,
+                                                     AI_PROTO_MAX_BATCH_REQUEST_SIZE);
+        batches_until_keyframe = AI_KEYFRAME_INTERVAL;
+    } else {
+        frame_len = ai_protocol_encode_batch_delta(batch, sequence,
+                                                   game_state_dirty,
+                                                   tx_frame_buffer,
+                                                   AI_PROTO_MAX_BATCH_REQUEST_SIZE);
+        batches_until_keyframe--;
     }
-    
-    // Receive response (with timeout)
-    socklen_t addr_len = sizeof(ai_server);
-    int received = net_recvfrom(network_socket, network_buffer, NETWORK_BUFFER_SIZE - 1, 0,
-                               (struct sockaddr*)&ai_server, &addr_len);
-    
-    if (received > 0) {
-        network_buffer[received] = '\0';
-        return deserialize_ai_response(network_buffer, response);
+    if (frame_len < 0) {
+        // Keep the dirty bits: the fields never reached the wire, so
+        // the next batch must still carry them
+        printf("Failed to encode AI batch request\n");
+        return;
     }
-    
-    return -1;
+    game_state_dirty = 0;
+
+    // Send to AI engine (socket is non-blocking)
+    int sent = send_tx_frame(frame_len);
+
+    // Swap slots: the staged batch becomes the in-flight one (kept
+    // for the deadline fallback), and the displaced slot is staged
+    // into next interval. No copies either way.
+    AIBatchRequest* displaced = pending_batch->batch;
+    pending_batch->batch = batch;
+    staging_batch = displaced;
+
+    pending_batch->sequence = sequence;
+    pending_batch->sent_frame = frame_counter;
+    pending_batch->sent_time = gettime();
+    pending_batch->frame_len = frame_len;
+    pending_batch->retransmitted = false;
+
+    if (sent < 0) {
+        // Send buffer full or link down: let the deadline path handle it
+        pending_batch->sent_frame = frame_counter - rtt_deadline_frames();
+        pending_batch->retransmitted = true;  // nothing worth resending
+    } else {
+        telemetry_count(TELEM_BATCHES_SENT);
+    }
+    pending_batch->in_flight = true;
 }
 
 /*
  * Local AI processing fallback
  */
 static int process_ai_locally(AIRequest* request, AIResponse* response) {
-    // Simple local AI processing
     response->player_id = request->player_id;
     response->timestamp = gettime();
-    
-    // Basic difficulty adjustment
-    float performance = estimate_player_performance(request);
-    response->difficulty_adjustment = (performance - 0.6f) * 0.1f;  // Target 60% success
-    
-    // Basic input enhancement
+
+    // Controller policy (fixed-point on Gekko, see ai_control.h);
+    // targets 60% success, same model the server runs
+    AIControlPolicy policy;
+    ai_control_policy(request->gesture.confidence,
+                      calculate_input_consistency(request),
+                      request->player_profile.skill_level,
+                      request->game_state.difficulty, &policy);
+
+    response->difficulty_adjustment = policy.difficulty_adjustment;
+
+    // Keep the current adaptation speed (the engine tunes this; the
+    // local fallback should not drift it)
+    response->learning_rate_adjustment = request->player_profile.adaptation_speed;
+
     response->input_enhancement.enabled = true;
-    response->input_enhancement.sensitivity_multiplier = 1.0f + (0.5f - request->player_profile.skill_level) * 0.2f;
-    
-    // Simple NPC behavior
-    response->npc_behavior.aggression = 0.3f + request->game_state.difficulty * 0.4f;
-    response->npc_behavior.intelligence = 0.5f + request->player_profile.skill_level * 0.3f;
-    
+    response->input_enhancement.sensitivity_multiplier =
+        policy.sensitivity_multiplier;
+
+    response->npc_behavior.aggression = policy.npc_aggression;
+    response->npc_behavior.intelligence = policy.npc_intelligence;
+
     return 0;
 }
 
@@ -416,8 +1239,11 @@ static int process_ai_locally(AIRequest* request, AIResponse* response) {
  */
 static void apply_ai_response(WiiPlayer* player, AIResponse* response) {
     // Update difficulty
-    current_game_state.difficulty += response->difficulty_adjustment;
-    current_game_state.difficulty = fmaxf(0.1f, fminf(1.0f, current_game_state.difficulty));
+    current_game_state.difficulty = ai_control_clamp_difficulty(
+        current_game_state.difficulty + response->difficulty_adjustment);
+    if (response->difficulty_adjustment != 0.0f) {
+        game_state_dirty |= GS_DIRTY_DIFFICULTY;
+    }
     
     // Update player assistance level
     if (response->input_enhancement.enabled) {
@@ -429,53 +1255,53 @@ static void apply_ai_response(WiiPlayer* player, AIResponse* response) {
 }
 
 /*
- * Update game-wide AI systems
+ * Pipeline job mixes. Queued instead of run inline; the scheduler
+ * drains them across the following frames under budget. Difficulty
+ * first: NPC behavior reads what it decides.
  */
-static void update_game_ai(void) {
-    // Update NPCs based on current game state
+static void queue_core_game_jobs(void) {
+    ai_scheduler_push(AI_JOB_GLOBAL_DIFFICULTY, 0, NULL);
+
     for (int i = 0; i < MAX_PLAYERS; i++) {
         if (players[i].connected) {
-            update_npc_behavior_for_player(&players[i]);
+            ai_scheduler_push(AI_JOB_NPC_BEHAVIOR, 1, &players[i]);
         }
     }
-    
-    // Adjust global difficulty
-    adjust_global_difficulty();
-    
-    // Generate dynamic content if needed
-    if (current_game_state.game_type == GAME_TYPE_ADVENTURE) {
-        generate_dynamic_content();
-    }
+}
+
+static void queue_adventure_game_jobs(void) {
+    queue_core_game_jobs();
+    // Dynamic content is adventure-only plumbing; no other pipeline
+    // ever evaluates it (lowest priority)
+    ai_scheduler_push(AI_JOB_DYNAMIC_CONTENT, 2, NULL);
 }
 
 /*
- * Estimate player performance for AI feedback
+ * Input consistency for performance estimation: an O(1) read of the
+ * streaming timing estimator fed at ingest (update_timing_stats),
+ * replacing the per-cycle variance rescan of the 5-sample window
  */
-static float estimate_player_performance(AIRequest* request) {
-    // Simple performance estimation based on gesture accuracy and timing
-    float accuracy = request->gesture.confidence;
-    float consistency = calculate_input_consistency(request);
-    
-    return (accuracy + consistency) / 2.0f;
+static float calculate_input_consistency(AIRequest* request) {
+    int player_id = request->player_id;
+    if (player_id < 0 || player_id >= MAX_PLAYERS) return 0.5f;
+    return players[player_id].timing.consistency;
 }
 
 /*
- * Calculate input consistency for performance estimation
+ * Update player skill estimation (EWMA) from the latest gesture
+ * analysis and the streaming consistency estimate
  */
-static float calculate_input_consistency(AIRequest* request) {
-    if (request->input_count < 2) return 0.5f;
-    
-    float total_variance = 0.0f;
-    for (int i = 1; i < request->input_count; i++) {
-        InputSnapshot* prev = &request->recent_inputs[i-1];
-        InputSnapshot* curr = &request->recent_inputs[i];
-        
-        float time_diff = curr->timestamp - prev->timestamp;
-        total_variance += fabsf(time_diff - 16.67f);  // 60 FPS target
-    }
-    
-    float avg_variance = total_variance / (request->input_count - 1);
-    return fmaxf(0.0f, 1.0f - (avg_variance / 50.0f));  // Normalize
+static void update_skill_estimation(WiiPlayer* player, GestureAnalysis* gesture) {
+    // Confident, vigorous motion reads as skill; steady input cadence
+    // backs it up. Drift toward the blend at the profile's learning
+    // rate — the slow-moving consistency term keeps the difficulty
+    // controller from chasing single-window noise.
+    float motion = gesture->confidence * fminf(1.0f, gesture->intensity);
+    float performance = 0.7f * motion + 0.3f * player->timing.consistency;
+    player->skill_level +=
+        (performance - player->skill_level) * player->ai_profile.learning_rate;
+    player->skill_level = fmaxf(0.0f, fminf(1.0f, player->skill_level));
+    player->ai_profile.skill_level = player->skill_level;
 }
 
 /*
@@ -490,15 +1316,16 @@ WiiInput wii_ai_get_enhanced_input(int player_id) {
     }
     
     WiiPlayer* player = &players[player_id];
-    InputSnapshot* latest = &player->input_history.snapshots[
-        (player->input_history.write_index - 1 + INPUT_HISTORY_SIZE) % INPUT_HISTORY_SIZE
-    ];
-    
+    InputSnapshot latest;
+    if (input_history_latest(&player->input_history, &latest) != 0) {
+        return enhanced_input;
+    }
+
     // Copy basic input
-    enhanced_input.buttons = latest->buttons_held;
-    enhanced_input.accel = latest->accel;
-    enhanced_input.ir = latest->ir;
-    enhanced_input.gyro = latest->gyro;
+    enhanced_input.buttons = latest.buttons_held;
+    enhanced_input.accel = latest.accel;
+    enhanced_input.ir = latest.ir;
+    enhanced_input.gyro = latest.gyro;
     
     // Apply AI enhancements
     if (player->ai_assistance_level > 0.0f) {
@@ -507,8 +1334,9 @@ WiiInput wii_ai_get_enhanced_input(int player_id) {
         enhanced_input.accel.y *= player->ai_assistance_level;
         enhanced_input.accel.z *= player->ai_assistance_level;
         
-        // Add gesture prediction
-        GestureAnalysis gesture = analyze_gesture_pattern(&gesture_buffers[player_id]);
+        // Gesture prediction from the per-frame predictive layer:
+        // leads the plain analysis when a gesture is building
+        GestureAnalysis gesture = predicted_gestures[player_id];
         enhanced_input.predicted_gesture = gesture.type;
         enhanced_input.gesture_confidence = gesture.confidence;
     }
@@ -524,22 +1352,74 @@ GameState* wii_ai_get_game_state(void) {
 }
 
 /*
- * Set game type for AI optimization
+ * Set game type: installs the matching update pipeline so per-frame
+ * work is decided once here, not re-branched 60 times a second
  */
 void wii_ai_set_game_type(GameType type) {
     current_game_state.game_type = type;
+    game_state_dirty |= GS_DIRTY_GAME_TYPE;
+
+    if (type >= GAME_TYPE_MENU && type <= GAME_TYPE_FIGHTING) {
+        active_pipeline = &pipelines[type];
+    }
     printf("AI Bridge: Game type set to %d\n", type);
 }
 
+/*
+ * Update a player's score with dirty tracking for delta encoding
+ */
+void wii_ai_set_player_score(int player_id, s32 score) {
+    if (player_id < 0 || player_id >= MAX_PLAYERS) return;
+    current_game_state.player_scores[player_id] = score;
+    game_state_dirty |= GS_DIRTY_SCORE(player_id);
+}
+
+void wii_ai_mark_game_state_dirty(u8 bits) {
+    game_state_dirty |= bits;
+}
+
+/*
+ * Network health snapshot for instrumentation
+ */
+AINetworkStats wii_ai_get_network_stats(void) {
+    AINetworkStats stats;
+    stats.rtt_valid = rtt_seeded;
+    stats.srtt_us = srtt_us;
+    stats.rttvar_us = rttvar_us;
+    stats.retransmits = retransmit_count;
+    stats.stale_replies = stale_reply_count;
+    return stats;
+}
+
 /*
  * Cleanup AI bridge resources
  */
 void wii_ai_bridge_cleanup(void) {
+    // Bring-up threads are short-lived but may still be mid-DHCP on a
+    // fast shutdown; join before tearing their targets down
+    if (fat_thread != LWP_THREAD_NULL) {
+        LWP_JoinThread(fat_thread, NULL);
+        fat_thread = LWP_THREAD_NULL;
+    }
+    if (net_thread != LWP_THREAD_NULL) {
+        LWP_JoinThread(net_thread, NULL);
+        net_thread = LWP_THREAD_NULL;
+    }
+
+    input_thread_stop();
+    trace_recorder_stop();
+    profile_store_stop(players);
+
     if (network_socket >= 0) {
         net_close(network_socket);
         network_socket = -1;
     }
     
+    if (response_cache_hits > 0) {
+        printf("AI response cache: %u round trips avoided\n",
+               response_cache_hits);
+    }
+
     ai_bridge_initialized = false;
     printf("Wii AI Bridge cleaned up\n");
 }